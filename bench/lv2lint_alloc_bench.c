@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: Hanspeter Portner <dev@open-music-kontrollers.ch>
+ * SPDX-License-Identifier: Artistic-2.0
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <lv2lint/lv2lint_shm.h>
+
+#define SIZE 64
+
+typedef struct _libc_t libc_t;
+typedef struct _job_t job_t;
+typedef double (*bench_t)(const libc_t *libc, unsigned iterations);
+
+struct _libc_t {
+	void *(*malloc)(size_t);
+	void  (*free)(void *);
+	int   (*pthread_mutex_lock)(pthread_mutex_t *);
+	int   (*pthread_mutex_unlock)(pthread_mutex_t *);
+};
+
+struct _job_t {
+	const libc_t *libc;
+	bench_t bench;
+	unsigned iterations;
+	double ns;
+};
+
+static inline uint64_t
+_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static double
+_bench_libc_malloc(const libc_t *libc, unsigned iterations)
+{
+	const uint64_t t0 = _now();
+
+	for(unsigned i = 0; i < iterations; i++)
+	{
+		void *volatile ptr = libc->malloc(SIZE);
+
+		libc->free(ptr);
+	}
+
+	return (double)(_now() - t0) / iterations;
+}
+
+static double
+_bench_malloc(const libc_t *libc __attribute__((unused)), unsigned iterations)
+{
+	const uint64_t t0 = _now();
+
+	for(unsigned i = 0; i < iterations; i++)
+	{
+		void *volatile ptr = malloc(SIZE);
+
+		free(ptr);
+	}
+
+	return (double)(_now() - t0) / iterations;
+}
+
+static double
+_bench_libc_mutex(const libc_t *libc, unsigned iterations)
+{
+	pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+	const uint64_t t0 = _now();
+
+	for(unsigned i = 0; i < iterations; i++)
+	{
+		libc->pthread_mutex_lock(&mutex);
+		libc->pthread_mutex_unlock(&mutex);
+	}
+
+	return (double)(_now() - t0) / iterations;
+}
+
+static double
+_bench_mutex(const libc_t *libc __attribute__((unused)), unsigned iterations)
+{
+	pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+	const uint64_t t0 = _now();
+
+	for(unsigned i = 0; i < iterations; i++)
+	{
+		pthread_mutex_lock(&mutex);
+		pthread_mutex_unlock(&mutex);
+	}
+
+	return (double)(_now() - t0) / iterations;
+}
+
+static void *
+_thread(void *data)
+{
+	job_t *job = data;
+
+	job->ns = job->bench(job->libc, job->iterations);
+
+	return NULL;
+}
+
+static double
+_churn(const libc_t *libc, bench_t bench, unsigned iterations, unsigned nthreads)
+{
+	pthread_t threads [nthreads];
+	job_t jobs [nthreads];
+	double ns = 0.0;
+
+	for(unsigned t = 0; t < nthreads; t++)
+	{
+		job_t *job = &jobs[t];
+
+		job->libc = libc;
+		job->bench = bench;
+		job->iterations = iterations;
+		job->ns = 0.0;
+
+		pthread_create(&threads[t], NULL, _thread, job);
+	}
+
+	for(unsigned t = 0; t < nthreads; t++)
+	{
+		pthread_join(threads[t], NULL);
+
+		ns += jobs[t].ns;
+	}
+
+	return ns / nthreads;
+}
+
+static void
+_report(const char *label, const libc_t *libc, bench_t ref, bench_t bench,
+	unsigned iterations, unsigned nthreads)
+{
+	const double ns_ref = _churn(libc, ref, iterations, nthreads);
+	const double ns = _churn(libc, bench, iterations, nthreads);
+
+	fprintf(stdout, "%-24s %2u thread(s): %8.2f ns (libc %8.2f ns, overhead %+8.2f ns)\n",
+		label, nthreads, ns, ns_ref, ns - ns_ref);
+}
+
+int
+main(int argc, char **argv)
+{
+	const unsigned iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+	const long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+	const unsigned nthreads = argc > 2
+		? strtoul(argv[2], NULL, 10)
+		: ncpus > 0 ? (unsigned)ncpus : 1;
+
+	void *handle = dlopen("libc.so.6", RTLD_LAZY | RTLD_NOLOAD);
+	if(!handle)
+	{
+		fprintf(stderr, "dlopen failed: %s\n", dlerror());
+		return 1;
+	}
+
+	libc_t libc;
+
+	*(void **)&libc.malloc = dlsym(handle, "malloc");
+	*(void **)&libc.free = dlsym(handle, "free");
+	*(void **)&libc.pthread_mutex_lock = dlsym(handle, "pthread_mutex_lock");
+	*(void **)&libc.pthread_mutex_unlock = dlsym(handle, "pthread_mutex_unlock");
+
+	if(!libc.malloc || !libc.free || !libc.pthread_mutex_lock
+		|| !libc.pthread_mutex_unlock)
+	{
+		fprintf(stderr, "dlsym failed: %s\n", dlerror());
+		dlclose(handle);
+		return 1;
+	}
+
+	if(dlsym(RTLD_DEFAULT, "malloc") == *(void **)&libc.malloc)
+	{
+		fprintf(stderr, "interposer not preloaded, measuring libc against itself\n");
+	}
+
+	shm_t *shm = shm_attach();
+	if(!shm)
+	{
+		dlclose(handle);
+		return 1;
+	}
+
+	for(unsigned n = 1; ; n = n*2 < nthreads ? n*2 : nthreads)
+	{
+		shm_disable(shm);
+		_report("malloc+free (disabled)", &libc, _bench_libc_malloc, _bench_malloc,
+			iterations, n);
+		_report("mutex (disabled)", &libc, _bench_libc_mutex, _bench_mutex,
+			iterations, n);
+
+		shm_enable(shm);
+		_report("malloc+free (enabled)", &libc, _bench_libc_malloc, _bench_malloc,
+			iterations, n);
+		_report("mutex (enabled)", &libc, _bench_libc_mutex, _bench_mutex,
+			iterations, n);
+		shm_disable(shm);
+
+		if(n == nthreads)
+		{
+			break;
+		}
+	}
+
+	shm_detach();
+	dlclose(handle);
+
+	return 0;
+}
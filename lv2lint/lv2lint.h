@@ -17,6 +17,7 @@
 #include <lilv/lilv.h>
 
 #include <varchunk/varchunk.h>
+#include <mapper.lv2/mapper.h>
 
 #include <lv2/worker/worker.h>
 #include <lv2/state/state.h>
@@ -63,6 +64,10 @@ typedef enum _ansi_color_t {
 extern const char *colors [2][ANSI_COLOR_MAX];
 
 typedef union _port_t port_t;
+typedef struct _buf_t buf_t;
+typedef struct _misalign_t misalign_t;
+typedef struct _rollup_t rollup_t;
+typedef struct _occurrence_t occurrence_t;
 typedef union _var_t var_t;
 typedef struct _white_t white_t;
 typedef struct _urid_t urid_t;
@@ -71,6 +76,7 @@ typedef struct _test_t test_t;
 typedef struct _ret_t ret_t;
 typedef struct _dst_t dst_t;
 typedef struct _res_t res_t;
+typedef struct _dsp_t dsp_t;
 typedef const ret_t *(*test_cb_t)(app_t *app);
 typedef int (*wrap_t)(app_t *app, void *data);
 typedef int (*parent_t)(app_t *, pid_t);
@@ -113,7 +119,10 @@ struct _res_t {
 	bool is_whitelisted;
 };
 
-#define PORT_NSAMPLES 32 //FIXME
+#define PORT_NSAMPLES 32 // block size of the conformance run()
+#define PORT_SEQUENCE_SIZE 2048 // bytes per atom sequence buffer
+#define DSP_NSAMPLES 256 // host-realistic block size of the run() benchmarks
+#define DSP_NSAMPLES_MAX 8192
 
 union _port_t {
 	float wav [PORT_NSAMPLES];
@@ -124,6 +133,13 @@ union _port_t {
 	} seq;
 };
 
+struct _buf_t {
+	port_t *port; // followed by a PROT_NONE guard page
+	size_t size;
+	uint8_t *map;
+	size_t map_size;
+};
+
 union _var_t {
 	uint32_t u32;
 	int32_t i32;
@@ -132,6 +148,118 @@ union _var_t {
 	double f64;
 };
 
+typedef enum _stim_t {
+	STIM_silence = 0,
+	STIM_noise,
+	STIM_sine,
+
+	STIM_MAX
+} stim_t;
+
+#define PERF_EPSILON 1e-5 // tolerated output difference between runs
+
+#define MISALIGN_MAX 3
+#define MISALIGN_OFFSET(IDX) ( ( (IDX) + 1) * sizeof(float) ) // 4, 8, 12 bytes
+
+struct _misalign_t {
+	bool valid;
+	bool differs;
+	double diff; // max absolute output difference
+	double aligned; // ns per sample
+	double misaligned;
+};
+
+typedef enum _counter_t {
+	COUNTER_cycles = 0,
+	COUNTER_instructions,
+	COUNTER_cache_references,
+	COUNTER_cache_misses,
+	COUNTER_branch_misses,
+	COUNTER_context_switches,
+
+	COUNTER_MAX
+} counter_t;
+
+#define PROFILE_MAX 4096 // samples
+#define PROFILE_DEPTH 32 // frames per sample
+#define PROFILE_TOP 5 // functions reported by self time
+#define PROFILE_NAME_MAX 256
+
+#define DENSITY_MAX 64 // additional instances
+
+#define CYCLE_COUNT 256 // deactivate, activate, run
+#define CYCLE_SETTLE 16 // cycles before sampling resources
+
+typedef enum _resource_t {
+	RESOURCE_heap = 0, // bytes in use
+	RESOURCE_rss, // bytes
+	RESOURCE_fds,
+	RESOURCE_threads,
+
+	RESOURCE_MAX
+} resource_t;
+
+#define COLD_BLOCKS 64 // run() calls timed with warm and cold caches each
+
+#define WSS_BLOCKS 16 // run() calls averaged per working set estimate
+
+typedef enum _wss_t {
+	WSS_heap = 0, // anonymous memory
+	WSS_dso, // code and data of the plugin DSO
+	WSS_ports, // port buffers
+	WSS_other, // libraries, stacks
+
+	WSS_MAX
+} wss_t;
+
+#define LEAK_TOP 5 // allocation sites reported by bytes leaked
+#define LEAK_NAME_MAX 128
+
+#define LAZY_FIRST 4 // run() calls after (re)activation timed separately
+#define LAZY_STEADY 64 // run() calls in steady state
+
+struct _rollup_t { // of /proc/self/smaps_rollup, in bytes
+	uint64_t rss;
+	uint64_t pss;
+	uint64_t anon;
+};
+
+#define SOAK_SAMPLE 1.0 // s between heap samples
+#define SOAK_STIM 4096 // blocks per stimulus
+#define SOAK_CONTROL 64 // blocks between control changes
+
+struct _occurrence_t {
+	uint64_t count; // blocks showing it
+	double first; // s into the soak
+};
+
+#define JITTER_SUB 4 // log-scale histogram bins per octave
+#define JITTER_BINS (40 * JITTER_SUB) // up to ~1000s
+
+struct _dsp_t {
+	bool valid;
+	double mean; // ns per sample
+	double p50;
+	double p99;
+	double max;
+};
+
+typedef enum _host_t {
+	HOST_map = 0,
+	HOST_unmap,
+	HOST_log,
+	HOST_schedule_work,
+	HOST_respond,
+
+	HOST_MAX
+} host_t;
+
+#if defined(__SSE__)
+#	define FPCR_MASK 0xffc0 // MXCSR control bits, without sticky exception flags
+#elif defined(__aarch64__)
+#	define FPCR_MASK 0x07c89f00 // FPCR control bits
+#endif
+
 typedef enum _stat_urid_t {
 	STAT_URID_INVALID = 0,
 
@@ -576,6 +704,9 @@ typedef enum _stat_urid_t {
 	INLINEDISPLAY__interface,
 	INLINEDISPLAY__queue_draw,
 
+	RTSAFE_MEMORY_POOL,
+	RTSAFE_MEMORY_POOL__Pool,
+
 	STAT_URID_MAX
 } stat_urid_t;
 
@@ -590,6 +721,7 @@ struct _app_t {
 	const LilvNode *parameter;
 	const LilvUI *ui;
 	const char *ui_uri;
+	mapper_t *mapper;
 	LV2_URID_Map *map;
 	LV2_URID_Unmap *unmap;
 	void *ui_instance;
@@ -633,6 +765,204 @@ struct _app_t {
 		unsigned run;
 		unsigned work_response;
 	} forbidden;
+#ifdef ENABLE_LIBM_TESTS
+	unsigned libm [LIBM_MAX];
+#endif
+	float sample_rate;
+	struct {
+		bool enabled;
+		uint32_t nsamples; // block size of all run() benchmarks
+		double duration; // s per stimulus, also of other run() benchmarks
+		double warn;
+		double fail;
+		dsp_t stim [STIM_MAX];
+	} dsp;
+	struct {
+		uint32_t blocks;
+		double limit;
+		uint64_t max;
+		uint32_t bins [JITTER_BINS];
+	} jitter;
+	struct {
+		bool valid;
+		double steady; // median ns per sample
+		double tail; // worst windowed median ns per sample
+		double onset; // seconds into the tail
+		uint64_t subnormals;
+	} denormal;
+	buf_t *bufs;
+	uint32_t nbufs;
+	struct {
+		bool caught;
+		phase_t phase;
+		uintptr_t addr;
+	} fault;
+	struct {
+		double limit; // KiB, warn above
+		uintptr_t bottom; // of the sandbox stack, 0 if not sandboxed
+		uintptr_t base; // frame below which the plugin is measured
+		phase_t phase; // callback measured in the current sandbox, if any
+		size_t depth [PHASE_MAX]; // high-water mark in bytes
+	} stack;
+	struct {
+		bool fixed; // bufsz:fixedBlockLength
+		bool pow2; // bufsz:powerOf2BlockLength
+		uint32_t min;
+		uint32_t max;
+		uint32_t calls;
+		uint32_t overruns;
+		uint32_t overrun; // n_samples of first overrun
+		bool valid;
+		uint32_t small;
+		double t_small; // median ns per call
+		double t_max;
+		double overhead; // ns per call
+	} block;
+	struct {
+		bool valid;
+		bool deterministic;
+		uint32_t pairs;
+		double diff; // max absolute output difference
+		double separate; // ns per sample
+		double inplace;
+	} inplace;
+	misalign_t misalign [MISALIGN_MAX];
+	struct {
+		char *path; // folded stacks output
+		uint32_t nsamples;
+		uint32_t hits; // samples inside the plugin
+		bool written;
+		uint8_t depth [PROFILE_MAX];
+		void *frames [PROFILE_MAX][PROFILE_DEPTH];
+		struct {
+			char *name;
+			uint32_t count;
+		} top [PROFILE_TOP];
+	} profile;
+	struct {
+		bool enabled;
+		bool valid;
+		int error; // errno of the group leader
+		int paranoid; // kernel.perf_event_paranoid
+		uint64_t samples;
+		bool avail [COUNTER_MAX];
+		uint64_t value [COUNTER_MAX];
+	} counters;
+	struct {
+		unsigned instances; // requested, 0 disables
+		unsigned n; // run concurrently, limited by the usable cores
+		bool valid;
+		bool deterministic; // instances running alone produce the same output
+		double single; // ns per block running alone
+		double concurrent; // mean ns per block running concurrently
+		double efficiency; // concurrent throughput relative to n times alone
+		uint64_t calls; // run() calls under contention
+		unsigned diverged; // instances differing from running alone
+		double diff; // max absolute output difference
+	} scaling;
+	struct {
+		bool enabled;
+		bool valid;
+		uint64_t first [LAZY_FIRST]; // ns of the first run() after activation
+		unsigned first_allocs;
+		uint64_t first_syscalls;
+		double steady; // median ns
+		unsigned steady_allocs;
+		uint64_t steady_syscalls;
+		uint64_t react [LAZY_FIRST]; // ns after reactivation
+		unsigned react_allocs;
+		uint64_t react_syscalls;
+	} lazy;
+	struct {
+		bool enabled;
+		bool valid;
+		double ns; // median per cycle
+		bool avail [RESOURCE_MAX];
+		double growth [RESOURCE_MAX]; // per cycle, last against first third
+		bool grows [RESOURCE_MAX]; // last third above first third throughout
+	} cycle;
+	struct {
+		bool enabled;
+		bool valid;
+		double kib [WSS_MAX]; // referenced per run()
+	} wss;
+	struct {
+		double duration; // s, 0 disables
+		bool valid;
+		bool seccomp; // syscalls stopped by a seccomp filter rather than all
+		uint64_t blocks;
+		double elapsed; // s of wall-clock time
+		occurrence_t shift [SHIFT_MAX];
+		occurrence_t syscall [SYSCALL_MAX];
+		occurrence_t overrun; // blocks missing the deadline
+		uint64_t max; // ns of the slowest block
+		unsigned samples;
+		bool monotonic; // heap never shrank between samples
+		int64_t heap [2]; // bytes in use at the first and last sample
+		int64_t rss [2];
+	} soak;
+	struct {
+		bool enabled;
+		bool valid;
+		size_t evict; // bytes streamed between run() calls
+		double warm; // median ns per block
+		double cold;
+	} cold;
+	struct {
+		bool enabled;
+		bool valid;
+		bool norun; // run() skipped, the worker belongs to the main instance
+		unsigned dropped; // allocations not tracked
+		usage_t live [PHASE_MAX]; // outstanding after cleanup by allocating phase
+		unsigned nsites;
+		struct {
+			char name [LEAK_NAME_MAX];
+			usage_t usage;
+		} top [LEAK_TOP];
+	} leak;
+	struct {
+		double limit; // ms, warn above
+		double budget; // MiB read, warn above
+		uint64_t ns;
+		unsigned files;
+		uint64_t read; // bytes
+		unsigned mmaps;
+		uint64_t mapped; // bytes
+		unsigned threads;
+	} instantiation;
+	struct {
+		bool enabled;
+		bool valid;
+		unsigned n; // additional instances, limited by the budget
+		uint64_t dso; // resident bytes of the plugin DSO, its .bss included
+		double rss; // marginal bytes per instance
+		double pss;
+		double duplicated; // identical pages per instance, in bytes
+	} density;
+	struct {
+		uint64_t syscalls;
+		uint64_t futexes;
+		bool seccomp; // resume with PTRACE_CONT, a filter stops at syscalls
+	} trace; // counted by the tracer while the interposer is enabled
+#ifdef FPCR_MASK
+	struct {
+		uint32_t entry;
+		uint32_t changed [PHASE_MAX];
+		uint32_t value [PHASE_MAX];
+	} fpcr;
+#endif
+	struct {
+		unsigned calls [PHASE_MAX][HOST_MAX];
+		unsigned mapped [PHASE_MAX];
+		unsigned untraced [PHASE_MAX];
+	} host;
+	struct {
+		bool offered;
+		size_t budget;
+		usage_t usage [PHASE_MAX];
+		unsigned failed [PHASE_MAX];
+		unsigned sleepy [PHASE_MAX];
+	} pool;
 	struct {
 		int instantiate;
 		int connect_port;
@@ -645,6 +975,22 @@ struct _app_t {
 		int work;
 		int work_response;
 		int state_restore;
+		int dsp;
+		int jitter;
+		int denormal;
+		int block;
+		int inplace;
+		int misalign [MISALIGN_MAX];
+		int counters;
+		int profile;
+		int scaling;
+		int density;
+		int lazy;
+		int cycle;
+		int leak;
+		int wss;
+		int cold;
+		int soak;
 	} status;
 	varchunk_t *to_worker;
 	varchunk_t *from_worker;
@@ -739,4 +1085,64 @@ lv2lint_append_to(char **dst, const char *src);
 int
 lv2lint_wrap(app_t *app, wrap_t wrap, void *data);
 
+void
+lv2lint_mempool_init(app_t *app, LV2_RtMemPool_Pool *pool);
+
+int
+lv2lint_perf_dsp(app_t *app, void *data);
+
+int
+lv2lint_perf_jitter(app_t *app, void *data);
+
+int
+lv2lint_perf_denormal(app_t *app, void *data);
+
+int
+lv2lint_perf_block(app_t *app, void *data);
+
+int
+lv2lint_perf_inplace(app_t *app, void *data);
+
+int
+lv2lint_perf_misalign(app_t *app, void *data);
+
+int
+lv2lint_perf_counters(app_t *app, void *data);
+
+int
+lv2lint_perf_profile(app_t *app, void *data);
+
+int
+lv2lint_perf_scaling(app_t *app, void *data);
+
+int
+lv2lint_perf_density(app_t *app, void *data);
+
+int
+lv2lint_perf_lazy(app_t *app, void *data);
+
+int
+lv2lint_perf_cycle(app_t *app, void *data);
+
+int
+lv2lint_perf_leak(app_t *app, void *data);
+
+int
+lv2lint_perf_wss(app_t *app, void *data);
+
+int
+lv2lint_perf_cold(app_t *app, void *data);
+
+int
+lv2lint_perf_soak(app_t *app, void *data);
+
+bool
+lv2lint_rollup(rollup_t *rollup);
+
+bool
+lv2lint_profile_fold(app_t *app);
+
+void
+lv2lint_profile_free(app_t *app);
+
 #endif
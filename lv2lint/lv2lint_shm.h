@@ -7,6 +7,8 @@
 #define _LV2LINT_ALLOC_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
 
 typedef enum _shift_t
 {
@@ -32,16 +34,107 @@ typedef enum _shift_t
 	SHIFT_nanosleep,
 	SHIFT_clock_nanosleep,
 
+	SHIFT_atomic_load,
+	SHIFT_atomic_store,
+	SHIFT_atomic_exchange,
+	SHIFT_atomic_compare_exchange,
+	SHIFT_atomic_load_16,
+	SHIFT_atomic_store_16,
+	SHIFT_atomic_exchange_16,
+	SHIFT_atomic_compare_exchange_16,
+
 	SHIFT_MAX
 } shift_t;
 
 #define MASK(VAL) (1 << VAL)
 
+#define MASK_ATOMIC ( \
+	MASK(SHIFT_atomic_load) | \
+	MASK(SHIFT_atomic_store) | \
+	MASK(SHIFT_atomic_exchange) | \
+	MASK(SHIFT_atomic_compare_exchange) | \
+	MASK(SHIFT_atomic_load_16) | \
+	MASK(SHIFT_atomic_store_16) | \
+	MASK(SHIFT_atomic_exchange_16) | \
+	MASK(SHIFT_atomic_compare_exchange_16) )
+
+typedef enum _libm_t
+{
+	LIBM_powf = 0,
+	LIBM_pow,
+	LIBM_expf,
+	LIBM_exp,
+	LIBM_exp2f,
+	LIBM_exp2,
+	LIBM_logf,
+	LIBM_log,
+	LIBM_log2f,
+	LIBM_log2,
+	LIBM_log10f,
+	LIBM_log10,
+	LIBM_sinf,
+	LIBM_sin,
+	LIBM_cosf,
+	LIBM_cos,
+	LIBM_tanf,
+	LIBM_tan,
+	LIBM_tanhf,
+	LIBM_tanh,
+	LIBM_atan2f,
+	LIBM_atan2,
+
+	LIBM_MAX
+} libm_t;
+
+typedef enum _phase_t
+{
+	PHASE_NONE = 0,
+	PHASE_instantiate,
+	PHASE_connect_port,
+	PHASE_activate,
+	PHASE_run,
+	PHASE_work,
+	PHASE_work_response,
+	PHASE_deactivate,
+	PHASE_cleanup,
+
+	PHASE_MAX
+} phase_t;
+
+#define LIVE_SLOTS 4096 // live allocations tracked at most, power of 2
+#define LIVE_DEPTH 8 // return addresses recorded per allocation
+#define LIVE_FREED ((void *)1) // tombstone of a freed slot
+
+typedef struct _usage_t usage_t;
+typedef struct _live_t live_t;
 typedef struct _shm_t shm_t;
 
+struct _usage_t {
+	unsigned count;
+	size_t bytes;
+};
+
+struct _live_t {
+	void *ptr; // NULL if empty, LIVE_FREED if freed
+	size_t size;
+	phase_t phase;
+	unsigned depth;
+	void *frames [LIVE_DEPTH]; // innermost first
+};
+
 struct _shm_t {
+	bool watch; // any of enabled, phase or tracking set and not paused
 	bool enabled;
+	bool paused; // within host code called by the plugin
+	phase_t phase;
 	unsigned mask;
+	unsigned libm [LIBM_MAX];
+	usage_t heap [PHASE_MAX]; // allocated within each phase
+	bool tracking;
+	atomic_flag lock;
+	unsigned dropped; // allocations not tracked for lack of slots
+	usage_t outstanding [PHASE_MAX]; // tracked and not yet freed, by phase
+	live_t live [LIVE_SLOTS];
 };
 
 shm_t *
@@ -56,7 +149,7 @@ shm_resume(shm_t *shm);
 void
 shm_enable(shm_t *shm);
 
-void
+bool
 shm_pause(shm_t *shm);
 
 unsigned
@@ -65,4 +158,16 @@ shm_disable(shm_t *shm);
 bool
 shm_enabled(shm_t *shm);
 
+void
+shm_enter(shm_t *shm, phase_t phase);
+
+void
+shm_leave(shm_t *shm);
+
+void
+shm_track(shm_t *shm);
+
+void
+shm_untrack(shm_t *shm);
+
 #endif
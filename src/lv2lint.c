@@ -6,11 +6,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <getopt.h>
 #include <unistd.h>
 #include <string.h>
 #include <assert.h>
 #include <signal.h>
 #include <errno.h>
+#include <time.h>
 #if defined(HAS_FNMATCH)
 #	include <fnmatch.h>
 #endif
@@ -23,6 +25,10 @@
 
 #include <lv2lint/lv2lint.h>
 
+#if defined(__SSE__)
+#	include <xmmintrin.h>
+#endif
+
 #include <lv2/patch/patch.h>
 #include <lv2/atom/atom.h>
 #include <lv2/worker/worker.h>
@@ -52,6 +58,9 @@
 #include <mapper.lv2/mapper.h>
 
 #define STACK_SIZE (1024 * 1024)
+#define STACK_PAINT 0x5354414b5354414bULL // painted before, looked for after
+#define STACK_SPARE 256 // bytes below the marking frame not painted
+#define BUF_ALIGN 16 // port buffer alignment
 
 typedef struct _wrap_data_t {
 	app_t *app;
@@ -527,7 +536,10 @@ static const char *stat_uris [STAT_URID_MAX] = {
 	ITM(EXTERNAL_UI__Widget),
 
 	ITM(INLINEDISPLAY__interface),
-	ITM(INLINEDISPLAY__queue_draw)
+	ITM(INLINEDISPLAY__queue_draw),
+
+	[RTSAFE_MEMORY_POOL] = LV2_RTSAFE_MEMORY_POOL_URI,
+	ITM(RTSAFE_MEMORY_POOL__Pool)
 };
 
 #undef ITM
@@ -566,10 +578,62 @@ _free_urids(app_t *app)
 	app->nurids = 0;
 }
 
+// host callbacks pause the interposer, as their allocations are not the plugin's
+static inline bool
+_host_enter(app_t *app, host_t host)
+{
+	app->host.calls[app->shm->phase][host]++;
+
+	return shm_pause(app->shm);
+}
+
+static inline void
+_host_leave(app_t *app, bool paused)
+{
+	if(!paused)
+	{
+		shm_resume(app->shm);
+	}
+}
+
+static LV2_URID
+_map(LV2_URID_Map_Handle instance, const char *uri)
+{
+	app_t *app = instance;
+	const bool paused = _host_enter(app, HOST_map);
+	const uint32_t usage = mapper_get_usage(app->mapper);
+
+	const LV2_URID urid = app->map->map(app->map->handle, uri);
+
+	if(mapper_get_usage(app->mapper) != usage)
+	{
+		app->host.mapped[app->shm->phase]++;
+	}
+
+	_host_leave(app, paused);
+
+	return urid;
+}
+
+static const char *
+_unmap(LV2_URID_Unmap_Handle instance, LV2_URID urid)
+{
+	app_t *app = instance;
+	const bool paused = _host_enter(app, HOST_unmap);
+
+	const char *uri = app->unmap->unmap(app->unmap->handle, urid);
+
+	_host_leave(app, paused);
+
+	return uri;
+}
+
 static LV2_Worker_Status
 _sched(LV2_Worker_Schedule_Handle instance, uint32_t size, const void *data)
 {
 	app_t *app = instance;
+	const bool paused = _host_enter(app, HOST_schedule_work);
+	LV2_Worker_Status status = LV2_WORKER_ERR_NO_SPACE;
 	void *tar;
 
 	if( (tar = varchunk_write_request(app->to_worker, size)) )
@@ -577,16 +641,20 @@ _sched(LV2_Worker_Schedule_Handle instance, uint32_t size, const void *data)
 		memcpy(tar, data, size);
 
 		varchunk_write_advance(app->to_worker, size);
-		return LV2_WORKER_SUCCESS;
+		status = LV2_WORKER_SUCCESS;
 	}
 
-	return LV2_WORKER_ERR_NO_SPACE;
+	_host_leave(app, paused);
+
+	return status;
 }
 
 static LV2_Worker_Status
 _respond(LV2_Worker_Respond_Handle instance, uint32_t size, const void *data)
 {
 	app_t *app = instance;
+	const bool paused = _host_enter(app, HOST_respond);
+	LV2_Worker_Status status = LV2_WORKER_ERR_NO_SPACE;
 	void *tar;
 
 	if( (tar = varchunk_write_request(app->from_worker, size)) )
@@ -594,10 +662,90 @@ _respond(LV2_Worker_Respond_Handle instance, uint32_t size, const void *data)
 		memcpy(tar, data, size);
 
 		varchunk_write_advance(app->from_worker, size);
-		return LV2_WORKER_SUCCESS;
+		status = LV2_WORKER_SUCCESS;
+	}
+
+	_host_leave(app, paused);
+
+	return status;
+}
+
+#ifdef FPCR_MASK
+static inline uint32_t
+_fpcr_get(void)
+{
+#if defined(__SSE__)
+	return _mm_getcsr();
+#elif defined(__aarch64__)
+	uint64_t fpcr;
+
+	__asm__ __volatile__("mrs %0, fpcr" : "=r" (fpcr));
+
+	return fpcr;
+#endif
+}
+
+static inline void
+_fpcr_set(uint32_t fpcr)
+{
+#if defined(__SSE__)
+	_mm_setcsr(fpcr);
+#elif defined(__aarch64__)
+	__asm__ __volatile__("msr fpcr, %0" : : "r" ((uint64_t)fpcr));
+#endif
+}
+#endif
+
+static inline void
+_phase_enter(app_t *app, phase_t phase)
+{
+#ifdef FPCR_MASK
+	app->fpcr.entry = _fpcr_get();
+#endif
+	shm_enter(app->shm, phase);
+}
+
+static inline void
+_phase_leave(app_t *app)
+{
+#ifdef FPCR_MASK
+	const phase_t phase = app->shm->phase;
+	const uint32_t fpcr = _fpcr_get();
+	const uint32_t changed = (fpcr ^ app->fpcr.entry) & FPCR_MASK;
+
+	if(changed)
+	{
+		app->fpcr.changed[phase] |= changed;
+		app->fpcr.value[phase] = fpcr;
+
+		_fpcr_set(app->fpcr.entry); // do not leak into subsequent phases
+	}
+#endif
+	shm_leave(app->shm);
+}
+
+// paint the sandbox stack below this frame, i.e. what the next call of the
+// caller may use
+__attribute__((noinline)) static void
+_stack_mark(app_t *app, phase_t phase)
+{
+	const uintptr_t base = (uintptr_t)__builtin_frame_address(0);
+
+	if(!app->stack.bottom)
+	{
+		return;
 	}
 
-	return LV2_WORKER_ERR_NO_SPACE;
+	uint64_t *word = (uint64_t *)app->stack.bottom;
+	const size_t nwords = (base - STACK_SPARE - app->stack.bottom) / sizeof(uint64_t);
+
+	for(size_t i = 0; i < nwords; i++)
+	{
+		word[i] = STACK_PAINT;
+	}
+
+	app->stack.base = base;
+	app->stack.phase = phase;
 }
 
 static int
@@ -608,6 +756,8 @@ _wrap_work(app_t *app, void *_data __attribute__((unused)))
 	const void *data;
 	size_t size;
 
+	_phase_enter(app, PHASE_work);
+
 	while( (data = varchunk_read_request(app->to_worker, &size)) )
 	{
 		if(app->work_iface && app->work_iface->work)
@@ -618,6 +768,8 @@ _wrap_work(app_t *app, void *_data __attribute__((unused)))
 		varchunk_read_advance(app->to_worker);
 	}
 
+	_phase_leave(app);
+
 	return status;
 }
 
@@ -629,7 +781,9 @@ _wrap_work_response(app_t *app, void *_data __attribute__((unused)))
 	const void *data;
 	size_t size;
 
+	_phase_enter(app, PHASE_work_response);
 	shm_enable(app->shm);
+	_stack_mark(app, PHASE_work_response);
 
 	while( (data = varchunk_read_request(app->from_worker, &size)) )
 	{
@@ -647,6 +801,7 @@ _wrap_work_response(app_t *app, void *_data __attribute__((unused)))
 	}
 
 	app->forbidden.work_response = shm_disable(app->shm);
+	_phase_leave(app);
 
 	return status;
 }
@@ -673,10 +828,11 @@ log_vprintf(void *data, LV2_URID type, const char *fmt,
 {
 	char *buf = NULL;
 	app_t *app = data;
+	const bool paused = _host_enter(app, HOST_log);
 
-	if(type == LOG__Trace)
+	if(type != LOG__Trace)
 	{
-		shm_pause(app->shm);
+		app->host.untraced[app->shm->phase]++;
 	}
 
 	if(vasprintf(&buf, fmt, args) == -1)
@@ -697,10 +853,7 @@ log_vprintf(void *data, LV2_URID type, const char *fmt,
 		free(buf);
 	}
 
-	if(type == LOG__Trace)
-	{
-		shm_resume(app->shm);
-	}
+	_host_leave(app, paused);
 
 	return 0;
 }
@@ -797,6 +950,57 @@ _version(char **argv)
 		"http://www.perlfoundation.org/artistic_license_2_0.\n\n");
 }
 
+enum {
+	OPT_POOL_BUDGET = 0x100, // long options without short equivalent
+	OPT_SAMPLE_RATE,
+	OPT_DSP_DURATION,
+	OPT_DSP_BLOCK,
+	OPT_DSP_WARN,
+	OPT_DSP_FAIL,
+	OPT_JITTER,
+	OPT_JITTER_LIMIT,
+	OPT_PERF_COUNTERS,
+	OPT_PROFILE,
+	OPT_INSTANCES,
+	OPT_DENSITY,
+	OPT_INSTANTIATE_LIMIT,
+	OPT_INSTANTIATE_BUDGET,
+	OPT_STACK_LIMIT,
+	OPT_COLD_CACHE,
+	OPT_SOAK,
+	OPT_DSP_LOAD,
+	OPT_LAZY_INIT,
+	OPT_CYCLES,
+	OPT_LEAKS,
+	OPT_WORKING_SET
+};
+
+static const struct option long_options [] = {
+	{"pool-budget", required_argument, NULL, OPT_POOL_BUDGET},
+	{"sample-rate", required_argument, NULL, OPT_SAMPLE_RATE},
+	{"dsp-duration", required_argument, NULL, OPT_DSP_DURATION},
+	{"dsp-block", required_argument, NULL, OPT_DSP_BLOCK},
+	{"dsp-warn", required_argument, NULL, OPT_DSP_WARN},
+	{"dsp-fail", required_argument, NULL, OPT_DSP_FAIL},
+	{"jitter", required_argument, NULL, OPT_JITTER},
+	{"jitter-limit", required_argument, NULL, OPT_JITTER_LIMIT},
+	{"perf-counters", no_argument, NULL, OPT_PERF_COUNTERS},
+	{"profile", required_argument, NULL, OPT_PROFILE},
+	{"instances", required_argument, NULL, OPT_INSTANCES},
+	{"density", no_argument, NULL, OPT_DENSITY},
+	{"instantiate-limit", required_argument, NULL, OPT_INSTANTIATE_LIMIT},
+	{"instantiate-budget", required_argument, NULL, OPT_INSTANTIATE_BUDGET},
+	{"stack-limit", required_argument, NULL, OPT_STACK_LIMIT},
+	{"cold-cache", no_argument, NULL, OPT_COLD_CACHE},
+	{"soak", required_argument, NULL, OPT_SOAK},
+	{"dsp-load", no_argument, NULL, OPT_DSP_LOAD},
+	{"lazy-init", no_argument, NULL, OPT_LAZY_INIT},
+	{"cycles", no_argument, NULL, OPT_CYCLES},
+	{"leaks", no_argument, NULL, OPT_LEAKS},
+	{"working-set", no_argument, NULL, OPT_WORKING_SET},
+	{NULL, 0, NULL, 0}
+};
+
 static void
 _usage(char **argv)
 {
@@ -832,7 +1036,29 @@ _usage(char **argv)
 
 		"   [-M] (no)pack                skip some tests for distribution packagers\n"
 		"   [-S] (no)warn|note|pass|all  show warnings, notes, passes or all\n"
-		"   [-E] (no)warn|note|all       treat warnings, notes or all as errors\n\n"
+		"   [-E] (no)warn|note|all       treat warnings, notes or all as errors\n"
+		"   [--pool-budget] BYTES        rtmempool budget per run (default: unlimited)\n"
+		"   [--sample-rate] HZ           sample rate to run plugins at (default: 48000)\n"
+		"   [--dsp-load]                 measure DSP load of run() per stimulus\n"
+		"   [--dsp-duration] SECONDS     audio duration per run() benchmark (default: 1)\n"
+		"   [--dsp-block] FRAMES         block size of run() benchmarks (default: 256)\n"
+		"   [--dsp-warn] PERCENT         warn above DSP load of one core (default: off)\n"
+		"   [--dsp-fail] PERCENT         fail above DSP load of one core (default: off)\n"
+		"   [--jitter] BLOCKS            record run() jitter over blocks (default: off)\n"
+		"   [--jitter-limit] PERCENT     warn above share of block deadline (default: 50)\n"
+		"   [--perf-counters]            report hardware performance counters of run()\n"
+		"   [--profile] FILE             sample run() call stacks into folded stacks file\n"
+		"   [--instances] N              run instances concurrently on pinned cores (default: off)\n"
+		"   [--density]                  measure memory cost per additional instance\n"
+		"   [--instantiate-limit] MS     warn above instantiation time (default: off)\n"
+		"   [--instantiate-budget] MIB   warn above bytes read when instantiating (default: 100)\n"
+		"   [--stack-limit] KIB          warn above stack used by realtime callbacks (default: 64)\n"
+		"   [--cold-cache]               measure run() with caches evicted before every block\n"
+		"   [--soak] SECONDS             run() for long with varied input (default: off)\n"
+		"   [--lazy-init]                detect lazy initialization in run()\n"
+		"   [--cycles]                   cycle activation and detect resources leaked per cycle\n"
+		"   [--leaks]                    check a second instance for heap leaked after cleanup()\n"
+		"   [--working-set]              estimate memory referenced per run()\n\n"
 		, argv[0]);
 }
 
@@ -1395,6 +1621,149 @@ _free_whitelist_libs(app_t *app)
 }
 #endif
 
+// the body ends flush with the guard page, thus the smallest overrun faults
+static bool
+_buf_alloc(buf_t *buf, size_t size, size_t align)
+{
+	const size_t page = sysconf(_SC_PAGESIZE);
+	const size_t body = (size + align - 1) & ~(align - 1);
+
+	buf->map_size = ( (body + page - 1) & ~(page - 1) ) + page;
+	buf->map = mmap(NULL, buf->map_size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if(buf->map == MAP_FAILED)
+	{
+		buf->map = NULL;
+		return false;
+	}
+
+	uint8_t *guard = buf->map + buf->map_size - page;
+
+	if(mprotect(guard, page, PROT_NONE) == -1)
+	{
+		return false;
+	}
+
+	// place the buffer right before the guard page, padded at the front only
+	buf->port = (port_t *)(guard - body);
+	buf->size = body;
+
+	return true;
+}
+
+static bool
+_bufs_alloc(app_t *app, size_t sequence_size)
+{
+	const uint32_t nports = lilv_plugin_get_num_ports(app->plugin);
+
+	app->bufs = calloc(nports, sizeof(buf_t));
+	if(!app->bufs)
+	{
+		return false;
+	}
+
+	app->nbufs = nports;
+
+	for(uint32_t p = 0; p < nports; p++)
+	{
+		const LilvPort *port = lilv_plugin_get_port_by_index(app->plugin, p);
+		buf_t *buf = &app->bufs[p];
+		size_t size = sizeof(port_t);
+		size_t align = BUF_ALIGN;
+		bool is_atom = true;
+
+		if(lilv_port_is_a(app->plugin, port, NODE(app, CORE__AudioPort))
+			|| lilv_port_is_a(app->plugin, port, NODE(app, CORE__CVPort)) )
+		{
+			// large enough for the conformance and the benchmark blocks
+			size = (app->dsp.nsamples > PORT_NSAMPLES
+				? app->dsp.nsamples : PORT_NSAMPLES) * sizeof(float);
+			is_atom = false;
+		}
+		else if(lilv_port_is_a(app->plugin, port, NODE(app, CORE__ControlPort)))
+		{
+			size = sizeof(float);
+			align = sizeof(float);
+			is_atom = false;
+		}
+		else if(lilv_port_is_a(app->plugin, port, NODE(app, ATOM__AtomPort)))
+		{
+			size = sequence_size;
+
+			LilvNodes *minimum_sizes = lilv_port_get_value(app->plugin, port,
+				NODE(app, RESIZE_PORT__minimumSize));
+			if(minimum_sizes)
+			{
+				const LilvNode *minimum_size = lilv_nodes_get_first(minimum_sizes);
+
+				if(minimum_size && lilv_node_is_int(minimum_size)
+					&& (lilv_node_as_int(minimum_size) > (int)size) )
+				{
+					size = lilv_node_as_int(minimum_size);
+				}
+
+				lilv_nodes_free(minimum_sizes);
+			}
+		}
+
+		if(!_buf_alloc(buf, size, align))
+		{
+			return false;
+		}
+
+		if(is_atom)
+		{
+			port_t *tar = buf->port;
+
+			tar->seq.atom.type = ATOM__Sequence;
+			if(lilv_port_is_a(app->plugin, port, NODE(app, CORE__InputPort)))
+			{
+				tar->seq.atom.size = sizeof(tar->seq.body);
+			}
+			else if(lilv_port_is_a(app->plugin, port, NODE(app, CORE__OutputPort)))
+			{
+				tar->seq.atom.size = buf->size - sizeof(LV2_Atom); // capacity up to the guard
+			}
+		}
+	}
+
+	return true;
+}
+
+static void
+_bufs_free(app_t *app)
+{
+	for(uint32_t p = 0; p < app->nbufs; p++)
+	{
+		buf_t *buf = &app->bufs[p];
+
+		if(buf->map)
+		{
+			munmap(buf->map, buf->map_size);
+		}
+	}
+
+	free(app->bufs);
+	app->bufs = NULL;
+	app->nbufs = 0;
+}
+
+#if defined(ENABLE_PTRACE_TESTS) || defined(ENABLE_WRAP_TESTS)
+static void
+_fault_catch(app_t *app, const void *addr)
+{
+	if(app->fault.caught)
+	{
+		return;
+	}
+
+	app->fault.caught = true;
+	app->fault.addr = (uintptr_t)addr;
+	app->fault.phase = app->shm->phase;
+}
+#endif
+
 #ifdef ENABLE_PTRACE_TESTS
 static int
 _trace_child(void *data)
@@ -1414,12 +1783,82 @@ _trace_child(void *data)
 	return wd->wrap(wd->app, wd->data);
 }
 
+#define TRACE_THREADS 64 // slots to pair syscall entries and exits per thread
+
+typedef struct _pending_t pending_t;
+
+struct _pending_t {
+	pid_t tid;
+	syscall_t call;
+	uint64_t len; // of mmap
+};
+
+static pending_t pending [TRACE_THREADS];
+
+static void
+_account_instantiation(app_t *app, const pending_t *pend, int64_t rval)
+{
+	switch(pend->call)
+	{
+		case SYSCALL_open:
+		case SYSCALL_openat:
+		case SYSCALL_openat2:
+		case SYSCALL_creat:
+		{
+			app->instantiation.files++;
+		} break;
+		case SYSCALL_read:
+		case SYSCALL_pread64:
+		case SYSCALL_readv:
+		case SYSCALL_preadv:
+		case SYSCALL_preadv2:
+		{
+			app->instantiation.read += rval;
+		} break;
+		case SYSCALL_mmap:
+		case SYSCALL_mmap2:
+		{
+			app->instantiation.mmaps++;
+			app->instantiation.mapped += pend->len;
+		} break;
+		case SYSCALL_clone:
+		case SYSCALL_clone3:
+		case SYSCALL_fork:
+		case SYSCALL_vfork:
+		{
+			if(rval > 0) // in the parent
+			{
+				app->instantiation.threads++;
+			}
+		} break;
+		default:
+		{
+			// nothing to do
+		} break;
+	}
+}
+
 static void
-_show_info(app_t *app, struct ptrace_syscall_info *info)
+_count_call(app_t *app, syscall_t call)
 {
-	static syscall_t call = SYSCALL_NONE;
+	app->trace.syscalls++;
 
-	if(!shm_enabled(app->shm))
+	if( (call == SYSCALL_futex) || (call == SYSCALL_futex_time64)
+		|| (call == SYSCALL_futex_waitv) )
+	{
+		app->trace.futexes++;
+	}
+}
+
+static void
+_show_info(app_t *app, pid_t tid, struct ptrace_syscall_info *info)
+{
+	pending_t *pend = &pending[tid % TRACE_THREADS];
+	const bool enabled = shm_enabled(app->shm);
+	const bool instantiation = (app->shm->phase == PHASE_instantiate)
+		&& !app->shm->paused;
+
+	if(!enabled && !instantiation)
 	{
 		return;
 	}
@@ -1428,22 +1867,50 @@ _show_info(app_t *app, struct ptrace_syscall_info *info)
 	{
 		case PTRACE_SYSCALL_INFO_ENTRY:
 		{
-			call = syscall_from_id(info->entry.nr);
+			pend->tid = tid;
+			pend->call = syscall_from_id(info->entry.nr);
+			pend->len = info->entry.args[1];
+
+			if(enabled)
+			{
+				_count_call(app, pend->call);
+			}
 		} break;
 		case PTRACE_SYSCALL_INFO_EXIT:
 		{
-			if(call != SYSCALL_NONE)
+			if( (pend->tid != tid) || (pend->call == SYSCALL_NONE) )
 			{
-				app->syscall[call] = true;
+				break;
 			}
+
+			if(enabled)
+			{
+				app->syscall[pend->call] = true;
+			}
+
+			if(instantiation && !info->exit.is_error)
+			{
+				_account_instantiation(app, pend, info->exit.rval);
+			}
+
+			pend->call = SYSCALL_NONE;
 		} break;
 		case PTRACE_SYSCALL_INFO_SECCOMP:
 		{
-			call = syscall_from_id(info->seccomp.nr);
+			// resumed with PTRACE_CONT, thus there is no exit to pair with
+			const syscall_t call = syscall_from_id(info->seccomp.nr);
+
+			pend->call = SYSCALL_NONE;
+
+			if(enabled)
+			{
+				_count_call(app, call);
+				app->syscall[call] = true;
+			}
 		} break;
 		case PTRACE_SYSCALL_INFO_NONE:
 		{
-			call = SYSCALL_NONE;
+			pend->call = SYSCALL_NONE;
 		} break;
 		default:
 		{
@@ -1460,14 +1927,21 @@ _trace_parent(app_t *app, pid_t kid)
 
 	while(true)
 	{
-		pid_t rc = waitpid(kid, &status, 0);
+		// threads of the kid are traced, too
+		pid_t rc = waitpid(-1, &status, __WALL);
 
-		if(rc != kid)
+		if(rc == -1)
 		{
 			fprintf(stderr, "cannot happen\n");
 			return 1;
 		}
 
+		if( (rc != kid) && (WIFEXITED(status) || WIFSIGNALED(status)) )
+		{
+			// thread is no more
+			continue;
+		}
+
 		if(WIFEXITED(status))
 		{
 			// kid is no more
@@ -1498,30 +1972,66 @@ _trace_parent(app_t *app, pid_t kid)
 		{
 			case SIGSTOP:
 			{
-				if(ptrace(PTRACE_SETOPTIONS, kid, 0, PTRACE_O_TRACESYSGOOD) < 0)
+				if(ptrace(PTRACE_SETOPTIONS, rc, 0,
+					PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE
+					| PTRACE_O_TRACESECCOMP) < 0)
 				{
 					fprintf(stderr, "sysgood failed\n");
 					return 1;
 				}
 
 				memset(&info, 0, sizeof(info));
-				if(ptrace(PTRACE_GET_SYSCALL_INFO, kid, sizeof(info), &info) < 0)
+				if(ptrace(PTRACE_GET_SYSCALL_INFO, rc, sizeof(info), &info) < 0)
 				{
 					fprintf(stderr, "syscall info failed\n");
 					return 1;
 				}
-				_show_info(app, &info); // non expected
+				_show_info(app, rc, &info); // non expected
 			} break;
 
 			case SIGTRAP | 0x80:
 			{
 				memset(&info, 0, sizeof(info));
-				if(ptrace(PTRACE_GET_SYSCALL_INFO, kid, sizeof(info), &info) < 0)
+				if(ptrace(PTRACE_GET_SYSCALL_INFO, rc, sizeof(info), &info) < 0)
 				{
 					fprintf(stderr, "syscall info failed\n");
 					return 1;
 				}
-				_show_info(app, &info);
+				_show_info(app, rc, &info);
+			} break;
+
+			case SIGTRAP:
+			{
+				if( (status >> 8) == (SIGTRAP | (PTRACE_EVENT_SECCOMP << 8)) )
+				{
+					memset(&info, 0, sizeof(info));
+					if(ptrace(PTRACE_GET_SYSCALL_INFO, rc, sizeof(info), &info) < 0)
+					{
+						fprintf(stderr, "syscall info failed\n");
+						return 1;
+					}
+					_show_info(app, rc, &info);
+				}
+				else if( (status >> 8) != (SIGTRAP | (PTRACE_EVENT_CLONE << 8)) )
+				{
+					fprintf(stderr, "unexpected trap\n");
+					kill(kid, SIGKILL);
+				}
+
+				// new threads start with a SIGSTOP of their own
+			} break;
+
+			case SIGSEGV:
+			case SIGBUS:
+			{
+				siginfo_t si;
+
+				if(ptrace(PTRACE_GETSIGINFO, rc, NULL, &si) == 0)
+				{
+					_fault_catch(app, si.si_addr);
+				}
+
+				kill(kid, SIGKILL);
 			} break;
 
 			default:
@@ -1531,7 +2041,8 @@ _trace_parent(app_t *app, pid_t kid)
 			} break;
 		}
 
-		ptrace(PTRACE_SYSCALL, kid, NULL, NULL);
+		// with a seccomp filter in place, only filtered syscalls stop
+		ptrace(app->trace.seccomp ? PTRACE_CONT : PTRACE_SYSCALL, rc, NULL, NULL);
 	}
 
 	return 0;
@@ -1539,10 +2050,32 @@ _trace_parent(app_t *app, pid_t kid)
 #endif
 
 #ifdef ENABLE_WRAP_TESTS
+// the child has its own copy of signal dispositions, but shares memory
+static app_t *fault_app = NULL;
+
+static void
+_fault(int sig __attribute__((unused)), siginfo_t *si,
+	void *ctx __attribute__((unused)))
+{
+	_fault_catch(fault_app, si->si_addr);
+
+	// returning re-raises the fault with the default disposition
+}
+
 static int
 _wrap_child(void *data)
 {
 	wrap_data_t *wd = data;
+	struct sigaction sa;
+
+	memset(&sa, 0x0, sizeof(sa));
+	sa.sa_sigaction = _fault;
+	sa.sa_flags = SA_SIGINFO | SA_RESETHAND;
+	sigemptyset(&sa.sa_mask);
+
+	fault_app = wd->app;
+	sigaction(SIGSEGV, &sa, NULL);
+	sigaction(SIGBUS, &sa, NULL);
 
 	return wd->wrap(wd->app, wd->data);
 }
@@ -1595,6 +2128,29 @@ _wrap_parent(app_t *app __attribute__((unused)), pid_t kid)
 	return 0;
 }
 
+static void
+_stack_scan(app_t *app, const char *stack)
+{
+	const uint64_t *word = (const uint64_t *)stack;
+	size_t i;
+
+	// the stack grows downwards, the lowest overwritten word is the high-water mark
+	for(i = 0; (i < STACK_SIZE / sizeof(uint64_t)) && (word[i] == STACK_PAINT); i++)
+	{
+		// search
+	}
+
+	const uintptr_t low = (uintptr_t)&word[i];
+	const phase_t phase = app->stack.phase;
+
+	if( (app->stack.base > low) && (app->stack.base - low > app->stack.depth[phase]) )
+	{
+		app->stack.depth[phase] = app->stack.base - low;
+	}
+
+	app->stack.phase = PHASE_NONE;
+}
+
 static int
 _wrap(app_t *app, wrap_t wrap, void *data, child_t child, parent_t parent)
 {
@@ -1612,6 +2168,8 @@ _wrap(app_t *app, wrap_t wrap, void *data, child_t child, parent_t parent)
 		return 1;
 	}
 
+	app->stack.bottom = (uintptr_t)stack;
+
 	char *stack_top = stack + STACK_SIZE;
 	const pid_t kid = clone(child, stack_top,
 		//CLONE_FILES | CLONE_FS | CLONE_IO | CLONE_VM | SIGCHLD, &wd);
@@ -1620,10 +2178,22 @@ _wrap(app_t *app, wrap_t wrap, void *data, child_t child, parent_t parent)
 	if(kid == -1)
 	{
 		fprintf(stderr, "[%s] clone failed: %s\n", __func__, strerror(errno));
+		app->stack.bottom = 0;
+		munmap(stack, STACK_SIZE);
 		return 1;
 	}
 
-	return parent(app, kid);
+	const int status = parent(app, kid);
+
+	if(app->stack.phase != PHASE_NONE) // set by the child while measuring
+	{
+		_stack_scan(app, stack);
+	}
+
+	app->stack.bottom = 0;
+	munmap(stack, STACK_SIZE);
+
+	return status;
 }
 #endif
 
@@ -1641,8 +2211,75 @@ static int
 _trace(app_t *app, wrap_t wrap, void *data)
 {
 #ifdef ENABLE_PTRACE_TESTS
-	return _wrap(app, wrap, data, _trace_child, _trace_parent);
+	const int status = _wrap(app, wrap, data, _trace_child, _trace_parent);
+
+	// a seccomp filter cannot be removed, it only goes with the traced child
+	app->trace.seccomp = false;
+
+	return status;
+#else
+	return wrap(app, data);
+#endif
+}
+
+// a cloned child shares the host's thread descriptor and may not create
+// threads, a forked one may, but only hands back its copy of `result`
+static int
+_trace_fork(app_t *app, wrap_t wrap, void *data, void *result, size_t size)
+{
+#ifdef ENABLE_WRAP_TESTS
+	wrap_data_t wd = {
+		.app = app,
+		.wrap = wrap,
+		.data = data
+	};
+#	ifdef ENABLE_PTRACE_TESTS
+	const child_t child = _trace_child;
+	const parent_t parent = _trace_parent;
+#	else
+	const child_t child = _wrap_child;
+	const parent_t parent = _wrap_parent;
+#	endif
+
+	void *shared = mmap(NULL, size, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	if(shared == MAP_FAILED)
+	{
+		return 1;
+	}
+
+	const pid_t kid = fork();
+
+	if(kid == -1)
+	{
+		fprintf(stderr, "[%s] fork failed: %s\n", __func__, strerror(errno));
+		munmap(shared, size);
+		return 1;
+	}
+
+	if(kid == 0)
+	{
+		const int status = child(&wd);
+
+		memcpy(shared, result, size);
+		_exit(status);
+	}
+
+	const int status = parent(app, kid);
+
+	if(status == 0)
+	{
+		memcpy(result, shared, size);
+	}
+
+	munmap(shared, size);
+
+	return status;
 #else
+	(void)result;
+	(void)size;
+
 	return wrap(app, data);
 #endif
 }
@@ -1650,10 +2287,41 @@ _trace(app_t *app, wrap_t wrap, void *data)
 static int
 _wrap_instantiate(app_t *app, void *data)
 {
-	const float param_sample_rate = 48000.f;
 	const LV2_Feature **features = data;
 
-	app->instance = lilv_plugin_instantiate(app->plugin, param_sample_rate, features);
+	_phase_enter(app, PHASE_instantiate);
+
+	app->instance = lilv_plugin_instantiate(app->plugin, app->sample_rate, features);
+
+	_phase_leave(app);
+
+	return 0;
+}
+
+// outside of any phase and untraced, thus not slowed down by either
+static int
+_wrap_instantiate_timed(app_t *app, void *data)
+{
+	const LV2_Feature **features = data;
+
+	struct timespec t0;
+	struct timespec t1;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	LilvInstance *instance = lilv_plugin_instantiate(app->plugin,
+		app->sample_rate, features);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	if(!instance)
+	{
+		return 0;
+	}
+
+	app->instantiation.ns = (t1.tv_sec - t0.tv_sec) * 1000000000ULL
+		+ t1.tv_nsec - t0.tv_nsec;
+
+	// unloads the DSO again, thus the traced pass sees it loaded, too
+	lilv_instance_free(instance);
 
 	return 0;
 }
@@ -1682,8 +2350,12 @@ _wrap_activate(app_t *app, void *data __attribute__((unused)))
 		return 1;
 	}
 
+	_phase_enter(app, PHASE_activate);
+
 	lilv_instance_activate(app->instance);
 
+	_phase_leave(app);
+
 	return 0;
 }
 
@@ -1695,8 +2367,12 @@ _wrap_deactivate(app_t *app, void *data __attribute__((unused)))
 		return 1;
 	}
 
+	_phase_enter(app, PHASE_deactivate);
+
 	lilv_instance_deactivate(app->instance);
 
+	_phase_leave(app);
+
 	return 0;
 }
 
@@ -1708,8 +2384,12 @@ _wrap_free(app_t *app, void *data __attribute__((unused)))
 		return 1;
 	}
 
+	_phase_enter(app, PHASE_cleanup);
+
 	lilv_instance_free(app->instance);
 
+	_phase_leave(app);
+
 	return 0;
 }
 
@@ -1723,11 +2403,14 @@ _wrap_connect_port(app_t *app, void *data)
 		return 1;
 	}
 
+	_phase_enter(app, PHASE_connect_port);
 	shm_enable(app->shm);
 
+	_stack_mark(app, PHASE_connect_port);
 	lilv_instance_connect_port(app->instance, dst->idx, dst->body);
 
 	app->forbidden.connect_port |= shm_disable(app->shm);
+	_phase_leave(app);
 
 	return 0;
 }
@@ -1740,11 +2423,18 @@ _wrap_run(app_t *app, void *data __attribute__((unused)))
 		return 1;
 	}
 
+	_phase_enter(app, PHASE_run);
 	shm_enable(app->shm);
 
+	_stack_mark(app, PHASE_run);
 	lilv_instance_run(app->instance, PORT_NSAMPLES);
 
 	app->forbidden.run = shm_disable(app->shm);
+	_phase_leave(app);
+
+#ifdef ENABLE_LIBM_TESTS
+	memcpy(app->libm, app->shm->libm, sizeof(app->libm));
+#endif
 
 	return 0;
 }
@@ -1758,6 +2448,12 @@ main(int argc, char **argv)
 	app.show = LINT_FAIL | LINT_WARN; // always report failed and warned tests
 	app.mask = LINT_FAIL; // always fail at failed tests
 	app.pck = true;
+	app.sample_rate = 48000.f;
+	app.dsp.nsamples = DSP_NSAMPLES;
+	app.dsp.duration = 1.0;
+	app.jitter.limit = 50.0;
+	app.instantiation.budget = 100.0;
+	app.stack.limit = 64.0;
 #ifdef ENABLE_ONLINE_TESTS
 	app.greet = "Dear LV2 plugin developer\n"
 		"\n"
@@ -1779,14 +2475,14 @@ main(int argc, char **argv)
 #endif
 
 	int c;
-	while( (c = getopt(argc, argv, "vhqdM:S:E:I:u:t:"
+	while( (c = getopt_long(argc, argv, "vhqdM:S:E:I:u:t:"
 #ifdef ENABLE_ONLINE_TESTS
 		"omg:"
 #endif
 #ifdef ENABLE_ELF_TESTS
 		"s:l:"
 #endif
-		) ) != -1)
+		, long_options, NULL) ) != -1)
 	{
 		switch(c)
 		{
@@ -1912,6 +2608,82 @@ main(int argc, char **argv)
 					app.mask &= ~(LINT_WARN | LINT_NOTE);
 				}
 
+				break;
+			case OPT_POOL_BUDGET:
+				app.pool.budget = strtoul(optarg, NULL, 10);
+				break;
+			case OPT_SAMPLE_RATE:
+				app.sample_rate = strtof(optarg, NULL);
+				break;
+			case OPT_DSP_BLOCK:
+				app.dsp.nsamples = strtoul(optarg, NULL, 10);
+				if(app.dsp.nsamples < PORT_NSAMPLES) // must hold the conformance run()
+				{
+					app.dsp.nsamples = PORT_NSAMPLES;
+				}
+				else if(app.dsp.nsamples > DSP_NSAMPLES_MAX)
+				{
+					app.dsp.nsamples = DSP_NSAMPLES_MAX;
+				}
+				break;
+			case OPT_DSP_DURATION:
+				app.dsp.duration = strtod(optarg, NULL);
+				break;
+			case OPT_DSP_WARN:
+				app.dsp.enabled = true;
+				app.dsp.warn = strtod(optarg, NULL);
+				break;
+			case OPT_DSP_FAIL:
+				app.dsp.enabled = true;
+				app.dsp.fail = strtod(optarg, NULL);
+				break;
+			case OPT_JITTER:
+				app.jitter.blocks = strtoul(optarg, NULL, 10);
+				break;
+			case OPT_JITTER_LIMIT:
+				app.jitter.limit = strtod(optarg, NULL);
+				break;
+			case OPT_PERF_COUNTERS:
+				app.counters.enabled = true;
+				break;
+			case OPT_PROFILE:
+				app.profile.path = optarg;
+				break;
+			case OPT_INSTANCES:
+				app.scaling.instances = strtoul(optarg, NULL, 10);
+				break;
+			case OPT_DENSITY:
+				app.density.enabled = true;
+				break;
+			case OPT_INSTANTIATE_LIMIT:
+				app.instantiation.limit = strtod(optarg, NULL);
+				break;
+			case OPT_INSTANTIATE_BUDGET:
+				app.instantiation.budget = strtod(optarg, NULL);
+				break;
+			case OPT_STACK_LIMIT:
+				app.stack.limit = strtod(optarg, NULL);
+				break;
+			case OPT_COLD_CACHE:
+				app.cold.enabled = true;
+				break;
+			case OPT_SOAK:
+				app.soak.duration = strtod(optarg, NULL);
+				break;
+			case OPT_DSP_LOAD:
+				app.dsp.enabled = true;
+				break;
+			case OPT_LAZY_INIT:
+				app.lazy.enabled = true;
+				break;
+			case OPT_CYCLES:
+				app.cycle.enabled = true;
+				break;
+			case OPT_LEAKS:
+				app.leak.enabled = true;
+				break;
+			case OPT_WORKING_SET:
+				app.wss.enabled = true;
 				break;
 			case '?':
 #ifdef ENABLE_ONLINE_TESTS
@@ -1930,6 +2702,20 @@ main(int argc, char **argv)
 		}
 	}
 
+	if(app.profile.path) // plugins append their folded stacks
+	{
+		FILE *f = fopen(app.profile.path, "w");
+
+		if(!f)
+		{
+			fprintf(stderr, "cannot open profile '%s': %s\n", app.profile.path,
+				strerror(errno));
+			return -1;
+		}
+
+		fclose(f);
+	}
+
 	if(optind == argc) // no URI given
 	{
 		_usage(argv);
@@ -1957,8 +2743,8 @@ main(int argc, char **argv)
 	if(!app.world)
 		return -1;
 
-	mapper_t *mapper = mapper_new(8192, STAT_URID_MAX, stat_uris, NULL, NULL, NULL);
-	if(!mapper)
+	app.mapper = mapper_new(8192, STAT_URID_MAX, stat_uris, NULL, NULL, NULL);
+	if(!app.mapper)
 		return -1;
 
 	app.to_worker = varchunk_new(0x10000, true);
@@ -1973,8 +2759,16 @@ main(int argc, char **argv)
 	lilv_world_load_all(app.world);
 	_load_include_dirs(&app);
 
-	app.map = mapper_get_map(mapper);
-	app.unmap = mapper_get_unmap(mapper);
+	app.map = mapper_get_map(app.mapper);
+	app.unmap = mapper_get_unmap(app.mapper);
+	LV2_URID_Map map = {
+		.handle = &app,
+		.map = _map
+	};
+	LV2_URID_Unmap unmap = {
+		.handle = &app,
+		.unmap = _unmap
+	};
 	LV2_Worker_Schedule sched = {
 		.handle = &app,
 		.schedule_work = _sched
@@ -1999,7 +2793,7 @@ main(int argc, char **argv)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 	LV2_URI_Map_Feature urimap = {
-		.callback_data = app.map,
+		.callback_data = &map,
 		.uri_to_id = uri_to_id
 	};
 #pragma GCC diagnostic pop
@@ -2007,19 +2801,20 @@ main(int argc, char **argv)
 		.handle = &app,
 		.queue_draw = _queue_draw
 	};
+	LV2_RtMemPool_Pool mempool;
+	lv2lint_mempool_init(&app, &mempool);
 
-	const float param_sample_rate = 48000.f;
 	const float ui_update_rate = 25.f;
-	const int32_t bufsz_min_block_length = 256;
-	const int32_t bufsz_max_block_length = 256;
-	const int32_t bufsz_nominal_block_length = 256;
-	const int32_t bufsz_sequence_size = 2048;
+	int32_t bufsz_min_block_length = 1; // set per plugin
+	const int32_t bufsz_max_block_length = app.dsp.nsamples;
+	const int32_t bufsz_nominal_block_length = app.dsp.nsamples;
+	const int32_t bufsz_sequence_size = PORT_SEQUENCE_SIZE;
 
 	const LV2_Options_Option opts_sampleRate = {
 		.key = PARAMETERS__sampleRate,
 		.size = sizeof(float),
 		.type = ATOM__Float,
-		.value = &param_sample_rate
+		.value = &app.sample_rate
 	};
 
 	const LV2_Options_Option opts_updateRate = {
@@ -2067,11 +2862,11 @@ main(int argc, char **argv)
 
 	const LV2_Feature feat_map = {
 		.URI = LV2_URID__map,
-		.data = app.map
+		.data = &map
 	};
 	const LV2_Feature feat_unmap = {
 		.URI = LV2_URID__unmap,
-		.data = app.unmap
+		.data = &unmap
 	};
 	const LV2_Feature feat_sched = {
 		.URI = LV2_WORKER__schedule,
@@ -2136,6 +2931,10 @@ main(int argc, char **argv)
 		.URI = LV2_INLINEDISPLAY__queue_draw,
 		.data = &queue_draw
 	};
+	const LV2_Feature feat_mempool = {
+		.URI = LV2_RTSAFE_MEMORY_POOL__Pool,
+		.data = &mempool
+	};
 
 	int ret = 0;
 	const LilvPlugin *plugins = lilv_world_get_all_plugins(app.world);
@@ -2150,10 +2949,70 @@ main(int argc, char **argv)
 				app.plugin = lilv_plugins_get_by_uri(plugins, plugin_uri_node);
 				if(app.plugin)
 				{
-#define MAX_FEATURES 21
+#define MAX_FEATURES 22
 					const LV2_Feature *features [MAX_FEATURES];
 					bool requires_bounded_block_length = false;
 
+					app.pool.offered = false;
+					memset(app.pool.usage, 0x0, sizeof(app.pool.usage));
+					memset(app.pool.failed, 0x0, sizeof(app.pool.failed));
+					memset(app.pool.sleepy, 0x0, sizeof(app.pool.sleepy));
+					memset(app.shm->heap, 0x0, sizeof(app.shm->heap));
+					memset(&app.host, 0x0, sizeof(app.host));
+					memset(app.dsp.stim, 0x0, sizeof(app.dsp.stim));
+					memset(app.jitter.bins, 0x0, sizeof(app.jitter.bins));
+					app.jitter.max = 0;
+					memset(&app.denormal, 0x0, sizeof(app.denormal));
+					memset(&app.block, 0x0, sizeof(app.block));
+					memset(&app.fault, 0x0, sizeof(app.fault));
+					memset(&app.inplace, 0x0, sizeof(app.inplace));
+					memset(&app.status, 0x0, sizeof(app.status)); // not all are run for every plugin
+					memset(app.misalign, 0x0, sizeof(app.misalign));
+					app.counters.valid = false;
+					app.counters.error = 0;
+					app.counters.paranoid = 0;
+					memset(app.counters.avail, 0x0, sizeof(app.counters.avail));
+					lv2lint_profile_free(&app);
+					app.scaling.valid = false;
+					app.scaling.n = 0;
+					app.scaling.diverged = 0;
+					app.scaling.diff = 0.0;
+					memset(&app.trace, 0x0, sizeof(app.trace));
+					app.density.valid = false;
+					app.density.n = 0;
+					{
+						const bool enabled = app.lazy.enabled; // from the command line
+						memset(&app.lazy, 0x0, sizeof(app.lazy));
+						app.lazy.enabled = enabled;
+					}
+					{
+						const bool enabled = app.cycle.enabled; // from the command line
+						memset(&app.cycle, 0x0, sizeof(app.cycle));
+						app.cycle.enabled = enabled;
+					}
+					{
+						const bool enabled = app.leak.enabled; // from the command line
+						memset(&app.leak, 0x0, sizeof(app.leak));
+						app.leak.enabled = enabled;
+					}
+					{
+						const bool enabled = app.wss.enabled; // from the command line
+						memset(&app.wss, 0x0, sizeof(app.wss));
+						app.wss.enabled = enabled;
+					}
+					app.cold.valid = false;
+					app.soak.valid = false;
+					memset(app.stack.depth, 0x0, sizeof(app.stack.depth));
+					app.instantiation.ns = 0;
+					app.instantiation.files = 0;
+					app.instantiation.read = 0;
+					app.instantiation.mmaps = 0;
+					app.instantiation.mapped = 0;
+					app.instantiation.threads = 0;
+#ifdef FPCR_MASK
+					memset(&app.fpcr, 0x0, sizeof(app.fpcr));
+#endif
+
 					// populate feature list
 					{
 						int f = 0;
@@ -2228,10 +3087,12 @@ main(int argc, char **argv)
 									case BUF_SIZE__fixedBlockLength:
 									{
 										features[f++] = &feat_fixedblocklength;
+										app.block.fixed = true;
 									}	break;
 									case BUF_SIZE__powerOf2BlockLength:
 									{
 										features[f++] = &feat_powerof2blocklength;
+										app.block.pow2 = true;
 									}	break;
 									case BUF_SIZE__coarseBlockLength:
 									{
@@ -2249,11 +3110,29 @@ main(int argc, char **argv)
 									{
 										features[f++] = &feat_idispqueuedraw;
 									}	break;
+									case RTSAFE_MEMORY_POOL:
+									case RTSAFE_MEMORY_POOL__Pool:
+									{
+										if(!app.pool.offered)
+										{
+											features[f++] = &feat_mempool;
+											app.pool.offered = true;
+										}
+									}	break;
 								}
 							}
 							lilv_nodes_free(required_features);
 						}
 
+						// plugins merely supporting the pool would fall back to the heap
+						if(!app.pool.offered
+							&& ( lilv_plugin_has_feature(app.plugin, NODE(&app, RTSAFE_MEMORY_POOL))
+								|| lilv_plugin_has_feature(app.plugin, NODE(&app, RTSAFE_MEMORY_POOL__Pool)) ) )
+						{
+							features[f++] = &feat_mempool;
+							app.pool.offered = true;
+						}
+
 						features[f++] = NULL; // sentinel
 						assert(f <= MAX_FEATURES);
 					}
@@ -2261,6 +3140,11 @@ main(int argc, char **argv)
 					// populate required option list
 					{
 						unsigned n_opts = 0;
+
+						// any size down to a single frame, unless the plugin is restricted
+						bufsz_min_block_length = app.block.fixed
+							? bufsz_max_block_length
+							: 1;
 						bool requires_min_block_length = false;
 						bool requires_max_block_length = false;
 
@@ -2318,6 +3202,11 @@ main(int argc, char **argv)
 
 						opts[n_opts++] = opts_sentinel; // sentinel
 						assert(n_opts <= MAX_OPTS);
+
+						app.block.min = (requires_min_block_length || requires_bounded_block_length)
+							? bufsz_min_block_length
+							: 0;
+						app.block.max = bufsz_max_block_length;
 					}
 
 #ifdef ENABLE_ONLINE_TESTS
@@ -2332,7 +3221,16 @@ main(int argc, char **argv)
 						lilv_node_as_uri(lilv_plugin_get_uri(app.plugin)),
 						colors[app.atty][ANSI_COLOR_RESET]);
 
-					app.status.instantiate = lv2lint_wrap(&app, _wrap_instantiate, (void *)features);
+					// timed without the tracer, which stops at every syscall
+					app.status.instantiate = lv2lint_wrap(&app, _wrap_instantiate_timed,
+						(void *)features);
+
+					if(!app.status.instantiate)
+					{
+						// traced for files, reads, mmaps and threads
+						app.status.instantiate = _trace(&app, _wrap_instantiate,
+							(void *)features);
+					}
 					app.descriptor = app.instance
 						? lilv_instance_get_descriptor(app.instance)
 						: NULL;
@@ -2364,48 +3262,121 @@ main(int argc, char **argv)
 
 						memset(app.syscall, 0, sizeof(bool)*SYSCALL_MAX); //FIXME
 
-						const size_t nports = lilv_plugin_get_num_ports(app.plugin);
-						const size_t ports_sz = sizeof(port_t) * nports;
-						port_t *ports = alloca(ports_sz);
-						memset(ports, 0x0, ports_sz);
-
 						app.status.connect_port = 0;
 						app.forbidden.connect_port = 0;
 
-						for(size_t p = 0; p < nports; p++)
+						if(!_bufs_alloc(&app, bufsz_sequence_size))
+						{
+							fprintf(stderr, "[%s] port buffer allocation failed\n", __func__);
+							_bufs_free(&app);
+							app.status.connect_port = 1;
+						}
+						else // no point in running without buffers
 						{
-							const LilvPort *port = lilv_plugin_get_port_by_index(app.plugin, p);
+							for(uint32_t p = 0; p < app.nbufs; p++)
+							{
+								dst_t dst = {
+									.idx = p,
+									.body = app.bufs[p].port
+								};
+
+								app.status.connect_port += _trace(&app, _wrap_connect_port, &dst);
+							}
 
-							port_t *tar = &ports[p];
-							tar->seq.atom.type = ATOM__Sequence;
-							if(lilv_port_is_a(app.plugin, port, NODE(&app, CORE__InputPort)))
+							app.status.activate = lv2lint_wrap(&app, _wrap_activate, NULL);
+
+							app.status.work = lv2lint_wrap(&app, _wrap_work, NULL);
+							app.status.work_response = _trace(&app, _wrap_work_response, NULL);
+
+							app.status.run = _trace(&app, _wrap_run, NULL);
+
+							app.status.work += lv2lint_wrap(&app, _wrap_work, NULL);
+							app.status.work_response += _trace(&app, _wrap_work_response, NULL);
+
+							if(app.dsp.enabled)
 							{
-								tar->seq.atom.size = sizeof(tar->seq.body);
+								app.status.dsp = lv2lint_wrap(&app, lv2lint_perf_dsp, app.bufs);
+								app.status.denormal = lv2lint_wrap(&app, lv2lint_perf_denormal, app.bufs);
 							}
-							else if(lilv_port_is_a(app.plugin, port, NODE(&app, CORE__OutputPort)))
+
+							if(app.jitter.blocks)
 							{
-								tar->seq.atom.size = sizeof(*tar);
+								app.status.jitter = lv2lint_wrap(&app, lv2lint_perf_jitter, app.bufs);
 							}
 
-							dst_t dst = {
-								.idx = p,
-								.body = tar
-							};
+							app.status.block = lv2lint_wrap(&app, lv2lint_perf_block, app.bufs);
 
-							app.status.connect_port += _trace(&app, _wrap_connect_port, &dst);
-						}
+							if(app.lazy.enabled)
+							{
+								app.status.lazy = _trace(&app, lv2lint_perf_lazy,
+									(void *)features);
+							}
+
+							if(app.cycle.enabled)
+							{
+								app.status.cycle = lv2lint_wrap(&app, lv2lint_perf_cycle, app.bufs);
+							}
+
+							if(app.leak.enabled)
+							{
+								app.status.leak = lv2lint_wrap(&app, lv2lint_perf_leak,
+									(void *)features);
+							}
+
+							if(app.wss.enabled)
+							{
+								app.status.wss = lv2lint_wrap(&app, lv2lint_perf_wss, app.bufs);
+							}
+
+							if(app.cold.enabled)
+							{
+								app.status.cold = lv2lint_wrap(&app, lv2lint_perf_cold, app.bufs);
+							}
+
+							if(!lilv_plugin_has_feature(app.plugin, NODE(&app, CORE__inPlaceBroken)))
+							{
+								app.status.inplace = lv2lint_wrap(&app, lv2lint_perf_inplace, app.bufs);
+							}
+
+							for(unsigned i = 0; i < MISALIGN_MAX; i++)
+							{
+								app.status.misalign[i] = lv2lint_wrap(&app, lv2lint_perf_misalign,
+									&app.misalign[i]);
+							}
 
-						app.status.activate = lv2lint_wrap(&app, _wrap_activate, NULL);
+							if(app.counters.enabled)
+							{
+								app.status.counters = lv2lint_wrap(&app, lv2lint_perf_counters, app.bufs);
+							}
 
-						app.status.work = lv2lint_wrap(&app, _wrap_work, NULL);
-						app.status.work_response = _trace(&app, _wrap_work_response, NULL);
+							if(app.profile.path)
+							{
+								app.status.profile = lv2lint_wrap(&app, lv2lint_perf_profile, app.bufs);
+								app.profile.written = !app.status.profile && lv2lint_profile_fold(&app);
+							}
 
-						app.status.run = _trace(&app, _wrap_run, NULL);
+							// the worker ring buffers are single producer
+							if(app.scaling.instances && !app.work_iface)
+							{
+								// the tracer counts into our copy while the interposer is enabled
+								memset(&app.trace, 0x0, sizeof(app.trace));
+								app.status.scaling = _trace_fork(&app, lv2lint_perf_scaling,
+									(void *)features, &app.scaling, sizeof(app.scaling));
+							}
 
-						app.status.work += lv2lint_wrap(&app, _wrap_work, NULL);
-						app.status.work_response += _trace(&app, _wrap_work_response, NULL);
+							if(app.density.enabled)
+							{
+								app.status.density = lv2lint_wrap(&app, lv2lint_perf_density,
+									(void *)features);
+							}
+
+							if(app.soak.duration > 0.0)
+							{
+								app.status.soak = _trace(&app, lv2lint_perf_soak, app.bufs);
+							}
 
-						app.status.deactivate = lv2lint_wrap(&app, _wrap_deactivate, NULL);
+							app.status.deactivate = lv2lint_wrap(&app, _wrap_deactivate, NULL);
+						}
 					}
 
 					if(!test_plugin(&app))
@@ -2502,6 +3473,8 @@ main(int argc, char **argv)
 						app.opts_iface = NULL;
 					}
 
+					_bufs_free(&app); // only after the instance is gone
+
 					app.plugin = NULL;
 
 				}
@@ -2522,6 +3495,7 @@ main(int argc, char **argv)
 		ret = -1;
 	}
 
+	lv2lint_profile_free(&app);
 	_unmap_uris(&app);
 	_free_urids(&app);
 	_free_include_dirs(&app);
@@ -2532,7 +3506,7 @@ main(int argc, char **argv)
 #endif
 	varchunk_free(app.to_worker);
 	varchunk_free(app.from_worker);
-	mapper_free(mapper);
+	mapper_free(app.mapper);
 
 	shm_detach();
 
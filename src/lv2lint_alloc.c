@@ -10,11 +10,58 @@
 #include <malloc.h>
 #include <semaphore.h>
 #include <time.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <execinfo.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
 
 #include <lv2lint/lv2lint_shm.h>
 
+/*
+ * Cost model of the interposed hot path, once initialized:
+ * - one acquire load of `state` and a well predicted branch
+ * - one load of `shm` and `shm->watch` and a well predicted branch
+ * - a call through the function pointer resolved via dlsym
+ *
+ * Only while watched, i.e. enabled, within a phase or tracking, are thread
+ * local flags read and masks and heap usage atomically updated in `shm`.
+ * While tracking live allocations, every allocation additionally unwinds the
+ * stack and every allocation and free updates a locked hash table in `shm`,
+ * together with the live bytes per allocating phase.
+ *
+ * Initialization is done at constructor time. Calls arriving before that
+ * (e.g. from constructors of other libraries) initialize lazily, calls from
+ * within dlsym itself are served from a static bootstrap buffer by every
+ * allocating entry point and calls from concurrent threads yield until the
+ * initializing thread has finished.
+ */
+
+#define BOOTSTRAP_SIZE 0x10000
+#define BOOTSTRAP_HEAD 16
+#define LIBM_SONAME "libm.so.6"
+#define LIBATOMIC_SONAME "libatomic.so.1"
+#define LIVE_SKIP 2 // frames of _track and the interposed function
+
+typedef enum _state_t {
+	STATE_NONE = 0,
+	STATE_BUSY,
+	STATE_DONE
+} state_t;
+
+static atomic_int state = STATE_NONE;
+// preloaded, thus in static TLS, sparing calls to __tls_get_addr
+static __thread bool initializing
+	__attribute__((tls_model("initial-exec"))) = false;
+static __thread bool resolving
+	__attribute__((tls_model("initial-exec"))) = false;
 static shm_t *shm = NULL;
 
+static uint8_t bootstrap [BOOTSTRAP_SIZE] __attribute__((aligned(BOOTSTRAP_HEAD)));
+static atomic_size_t bootstrap_offset = 0;
+
 static void *(*__malloc)(size_t) = NULL;
 static void  (*__free)(void *) = NULL;
 static void *(*__calloc)(size_t, size_t) = NULL;
@@ -39,9 +86,29 @@ static int   (*__nanosleep)(const struct timespec *, struct timespec *) = NULL;
 static int   (*__clock_nanosleep)(clockid_t, int, const struct timespec *,
 																	struct timespec *) = NULL;
 
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 atomic_16_t;
+#endif
+
+// libatomic is only resolved on first use, as it is loaded with the plugin
+static void  (*__libatomic_load)(size_t, void *, void *, int) = NULL;
+static void  (*__libatomic_store)(size_t, void *, void *, int) = NULL;
+static void  (*__libatomic_exchange)(size_t, void *, void *, void *, int) = NULL;
+static bool  (*__libatomic_compare_exchange)(size_t, void *, void *, void *,
+																						int, int) = NULL;
+#ifdef __SIZEOF_INT128__
+static atomic_16_t (*__libatomic_load_16)(const volatile void *, int) = NULL;
+static void  (*__libatomic_store_16)(volatile void *, atomic_16_t, int) = NULL;
+static atomic_16_t (*__libatomic_exchange_16)(volatile void *, atomic_16_t,
+																							int) = NULL;
+static bool  (*__libatomic_compare_exchange_16)(volatile void *, atomic_16_t *,
+																							atomic_16_t, bool, int, int) = NULL;
+#endif
+
 typedef struct _dict_t {
 	const char *name;
 	void **func;
+	bool missing; // not found on first use, not looked up again
 } dict_t;
 
 #define DICT(NAME) \
@@ -74,19 +141,156 @@ static dict_t dicts [SHIFT_MAX] = {
 	DICT(clock_nanosleep),
 };
 
+#define ATOMIC_DICT(NAME) \
+	[SHIFT_ ## NAME] = { \
+		.name = "__" #NAME, \
+		.func = (void **)&__lib ## NAME \
+	}
+
+static dict_t atomic_dicts [SHIFT_MAX] = {
+	ATOMIC_DICT(atomic_load),
+	ATOMIC_DICT(atomic_store),
+	ATOMIC_DICT(atomic_exchange),
+	ATOMIC_DICT(atomic_compare_exchange),
+#ifdef __SIZEOF_INT128__
+	ATOMIC_DICT(atomic_load_16),
+	ATOMIC_DICT(atomic_store_16),
+	ATOMIC_DICT(atomic_exchange_16),
+	ATOMIC_DICT(atomic_compare_exchange_16),
+#endif
+};
+
+#ifdef ENABLE_LIBM_TESTS
+static float (*__powf)(float, float) = NULL;
+static double (*__pow)(double, double) = NULL;
+static float (*__expf)(float) = NULL;
+static double (*__exp)(double) = NULL;
+static float (*__exp2f)(float) = NULL;
+static double (*__exp2)(double) = NULL;
+static float (*__logf)(float) = NULL;
+static double (*__log)(double) = NULL;
+static float (*__log2f)(float) = NULL;
+static double (*__log2)(double) = NULL;
+static float (*__log10f)(float) = NULL;
+static double (*__log10)(double) = NULL;
+static float (*__sinf)(float) = NULL;
+static double (*__sin)(double) = NULL;
+static float (*__cosf)(float) = NULL;
+static double (*__cos)(double) = NULL;
+static float (*__tanf)(float) = NULL;
+static double (*__tan)(double) = NULL;
+static float (*__tanhf)(float) = NULL;
+static double (*__tanh)(double) = NULL;
+static float (*__atan2f)(float, float) = NULL;
+static double (*__atan2)(double, double) = NULL;
+
+#define LIBM_DICT(NAME) \
+	[LIBM_ ## NAME] = { \
+		.name = #NAME, \
+		.func = (void **)&__ ## NAME \
+	}
+
+static dict_t libm_dicts [LIBM_MAX] = {
+	LIBM_DICT(powf),
+	LIBM_DICT(pow),
+	LIBM_DICT(expf),
+	LIBM_DICT(exp),
+	LIBM_DICT(exp2f),
+	LIBM_DICT(exp2),
+	LIBM_DICT(logf),
+	LIBM_DICT(log),
+	LIBM_DICT(log2f),
+	LIBM_DICT(log2),
+	LIBM_DICT(log10f),
+	LIBM_DICT(log10),
+	LIBM_DICT(sinf),
+	LIBM_DICT(sin),
+	LIBM_DICT(cosf),
+	LIBM_DICT(cos),
+	LIBM_DICT(tanf),
+	LIBM_DICT(tan),
+	LIBM_DICT(tanhf),
+	LIBM_DICT(tanh),
+	LIBM_DICT(atan2f),
+	LIBM_DICT(atan2),
+};
+#endif
+
+// the size is stored in the head right before the returned, aligned body
+static void *
+_bootstrap_alloc(size_t alignment, size_t size)
+{
+	if(alignment < BOOTSTRAP_HEAD)
+	{
+		alignment = BOOTSTRAP_HEAD;
+	}
+
+	if( (alignment & (alignment - 1)) || (alignment > BOOTSTRAP_SIZE)
+		|| (size > BOOTSTRAP_SIZE) )
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	// the head and padding up to the alignment fit into the first `alignment`
+	const size_t total = alignment
+		+ ((size + BOOTSTRAP_HEAD - 1) & ~(BOOTSTRAP_HEAD - 1));
+	const size_t offset = atomic_fetch_add_explicit(&bootstrap_offset, total,
+		memory_order_relaxed);
+
+	if(offset + total > BOOTSTRAP_SIZE)
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	const uintptr_t start = (uintptr_t)&bootstrap[offset] + BOOTSTRAP_HEAD;
+	uint8_t *body = (uint8_t *)((start + alignment - 1) & ~(alignment - 1));
+	*(size_t *)(body - BOOTSTRAP_HEAD) = size;
+
+	return body; // static storage, thus already zeroed
+}
+
+static inline bool
+_is_bootstrap(const void *ptr)
+{
+	return (ptr >= (const void *)bootstrap)
+		&& (ptr < (const void *)&bootstrap[BOOTSTRAP_SIZE]);
+}
+
+static inline size_t
+_bootstrap_size(const void *ptr)
+{
+	return *(const size_t *)((const uint8_t *)ptr - BOOTSTRAP_HEAD);
+}
+
 static void
 _init(void)
 {
-	shm = shm_attach();
-	if(!shm)
+	int expected = STATE_NONE;
+
+	if(!atomic_compare_exchange_strong(&state, &expected, STATE_BUSY))
 	{
-		fprintf(stderr, "Error in `shm_attach`: %s\n", dlerror());
+		// another thread is initializing, wait for it to finish
+		while(atomic_load_explicit(&state, memory_order_acquire) != STATE_DONE)
+		{
+			sched_yield();
+		}
+
+		return;
 	}
 
+	initializing = true;
+
 	for(shift_t s = 0; s < SHIFT_MAX; s++)
 	{
 		dict_t *dict = &dicts[s];
 
+		if(!dict->name) // resolved lazily
+		{
+			continue;
+		}
+
 		*(dict->func) = dlsym(RTLD_NEXT, dict->name);
 
 		if(*(dict->func) == NULL)
@@ -95,36 +299,225 @@ _init(void)
 				dict->name, dlerror());
 		}
 	}
+
+	shm = shm_attach();
+	if(!shm)
+	{
+		fprintf(stderr, "Error in `shm_attach`: %s\n", dlerror());
+	}
+
+	// the unwinder is loaded on first use, not from within a tracked allocation
+	void *frame;
+	backtrace(&frame, 1);
+
+	initializing = false;
+
+	atomic_store_explicit(&state, STATE_DONE, memory_order_release);
 }
 
-static void
+__attribute__((constructor)) static void
+_ctor(void)
+{
+	_init();
+}
+
+static inline bool
+_ready(void)
+{
+	if(__builtin_expect(atomic_load_explicit(&state, memory_order_acquire)
+		== STATE_DONE, true))
+	{
+		return true;
+	}
+
+	if(initializing) // recursive call from within _init, e.g. via dlsym
+	{
+		return false;
+	}
+
+	_init();
+
+	return true;
+}
+
+// the single test done before touching thread local storage or `shm` further
+static inline bool
+_watching(void)
+{
+	return __builtin_expect(shm && shm->watch, false);
+}
+
+static inline void
 _mask(shift_t shift)
 {
-	if(!shm)
+	if(!_watching() || resolving || !shm_enabled(shm))
+	{
+		return;
+	}
+
+	if(!(shm->mask & MASK(shift))) // avoid needless writes to shared cache line
+	{
+		shm->mask |= MASK(shift);
+	}
+}
+
+static inline void
+_account(size_t size)
+{
+	if(resolving || (shm->phase == PHASE_NONE) )
+	{
+		return;
+	}
+
+	usage_t *usage = &shm->heap[shm->phase];
+
+	// concurrent instances allocate from several threads at once
+	__atomic_fetch_add(&usage->count, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&usage->bytes, size, __ATOMIC_RELAXED);
+}
+
+static inline live_t *
+_slot(const void *ptr)
+{
+	return &shm->live[( ((uintptr_t)ptr >> 4) * 0x9e3779b1u) & (LIVE_SLOTS - 1)];
+}
+
+static inline live_t *
+_next(live_t *live)
+{
+	return (++live == &shm->live[LIVE_SLOTS]) ? shm->live : live;
+}
+
+static inline void
+_lock(void)
+{
+	while(atomic_flag_test_and_set_explicit(&shm->lock, memory_order_acquire))
 	{
-		_init();
+		// spin
+	}
+}
+
+static inline void
+_unlock(void)
+{
+	atomic_flag_clear_explicit(&shm->lock, memory_order_release);
+}
+
+// not inlined, so the number of frames to skip is known
+__attribute__((noinline)) static void
+_track(void *ptr, size_t size)
+{
+	void *frames [LIVE_SKIP + LIVE_DEPTH];
+
+	if(!ptr || resolving || !shm->tracking || (shm->phase == PHASE_NONE) )
+	{
+		return;
+	}
+
+	resolving = true; // the unwinder may allocate, do not track that
+	const int depth = backtrace(frames, LIVE_SKIP + LIVE_DEPTH);
+	resolving = false;
+
+	_lock();
+
+	live_t *live = _slot(ptr);
+
+	for(unsigned i = 0; i < LIVE_SLOTS; i++, live = _next(live))
+	{
+		if( (live->ptr != NULL) && (live->ptr != LIVE_FREED) )
+		{
+			continue;
+		}
+
+		live->ptr = ptr;
+		live->size = size;
+		live->phase = shm->phase;
+		live->depth = depth > LIVE_SKIP ? depth - LIVE_SKIP : 0;
+		memcpy(live->frames, &frames[LIVE_SKIP], live->depth * sizeof(void *));
+
+		shm->outstanding[live->phase].count++;
+		shm->outstanding[live->phase].bytes += size;
+
+		_unlock();
+		return;
 	}
 
-	if(!shm_enabled(shm))
+	shm->dropped++;
+
+	_unlock();
+}
+
+static inline void
+_untrack(void *ptr)
+{
+	if(!ptr || !shm->tracking)
 	{
 		return;
 	}
 
-	shm->mask |= MASK(shift);
+	_lock();
+
+	live_t *live = _slot(ptr);
+
+	for(unsigned i = 0; (i < LIVE_SLOTS) && live->ptr; i++, live = _next(live))
+	{
+		if(live->ptr == ptr)
+		{
+			shm->outstanding[live->phase].count--;
+			shm->outstanding[live->phase].bytes -= live->size;
+
+			live->ptr = LIVE_FREED;
+			break;
+		}
+	}
+
+	_unlock();
 }
 
 void *
 malloc(size_t size)
 {
+	if(!_ready())
+	{
+		return _bootstrap_alloc(0, size);
+	}
+
+	if(!_watching())
+	{
+		return __malloc(size);
+	}
+
 	_mask(SHIFT_malloc);
+	_account(size);
+
+	void *ptr = __malloc(size);
 
-	return __malloc(size);
+	_track(ptr, size);
+
+	return ptr;
 }
 
 void
 free(void *ptr)
 {
+	if(_is_bootstrap(ptr))
+	{
+		return; // bootstrap memory is never reclaimed
+	}
+
+	if(!_ready())
+	{
+		return;
+	}
+
+	if(!_watching())
+	{
+		__free(ptr);
+		return;
+	}
+
 	_mask(SHIFT_free);
+	_untrack(ptr);
 
 	__free(ptr);
 }
@@ -132,57 +525,205 @@ free(void *ptr)
 void *
 calloc(size_t nmemb, size_t size)
 {
+	if(!_ready())
+	{
+		if(size && (nmemb > SIZE_MAX / size) )
+		{
+			errno = ENOMEM;
+			return NULL;
+		}
+
+		return _bootstrap_alloc(0, nmemb * size);
+	}
+
+	if(!_watching())
+	{
+		return __calloc(nmemb, size);
+	}
+
 	_mask(SHIFT_calloc);
+	_account(nmemb * size);
+
+	void *ptr = __calloc(nmemb, size);
 
-	return __calloc(nmemb, size);
+	_track(ptr, nmemb * size);
+
+	return ptr;
 }
 
 void *
 realloc(void *ptr, size_t size)
 {
+	if(_is_bootstrap(ptr))
+	{
+		void *dst = malloc(size);
+
+		if(dst)
+		{
+			const size_t old = _bootstrap_size(ptr);
+
+			memcpy(dst, ptr, old < size ? old : size);
+		}
+
+		return dst;
+	}
+
+	if(!_ready())
+	{
+		return _bootstrap_alloc(0, size);
+	}
+
+	if(!_watching())
+	{
+		return __realloc(ptr, size);
+	}
+
 	_mask(SHIFT_realloc);
+	_account(size);
 
-	return __realloc(ptr, size);
+	void *dst = __realloc(ptr, size);
+
+	if(dst || !size) // the original block is gone
+	{
+		_untrack(ptr);
+	}
+
+	_track(dst, size);
+
+	return dst;
 }
 
 int
 posix_memalign(void **memptr, size_t alignment, size_t size)
 {
+	if(!_ready())
+	{
+		if( (alignment % sizeof(void *)) || (alignment & (alignment - 1)) )
+		{
+			return EINVAL;
+		}
+
+		*memptr = _bootstrap_alloc(alignment, size);
+
+		return *memptr ? 0 : ENOMEM;
+	}
+
+	if(!_watching())
+	{
+		return __posix_memalign(memptr, alignment, size);
+	}
+
 	_mask(SHIFT_posix_memalign);
+	_account(size);
+
+	const int err = __posix_memalign(memptr, alignment, size);
+
+	if(err == 0)
+	{
+		_track(*memptr, size);
+	}
 
-	return __posix_memalign(memptr, alignment, size);
+	return err;
 }
 
 void *
 aligned_alloc(size_t alignment, size_t size)
 {
+	if(!_ready())
+	{
+		return _bootstrap_alloc(alignment, size);
+	}
+
+	if(!_watching())
+	{
+		return __aligned_alloc(alignment, size);
+	}
+
 	_mask(SHIFT_aligned_alloc);
+	_account(size);
 
-	return __aligned_alloc(alignment, size);
+	void *ptr = __aligned_alloc(alignment, size);
+
+	_track(ptr, size);
+
+	return ptr;
 }
 
 void *
 valloc(size_t size)
 {
+	if(!_ready())
+	{
+		return _bootstrap_alloc(getpagesize(), size);
+	}
+
+	if(!_watching())
+	{
+		return __valloc(size);
+	}
+
 	_mask(SHIFT_valloc);
+	_account(size);
+
+	void *ptr = __valloc(size);
 
-	return __valloc(size);
+	_track(ptr, size);
+
+	return ptr;
 }
 
 void *
 memalign(size_t alignment, size_t size)
 {
+	if(!_ready())
+	{
+		return _bootstrap_alloc(alignment, size);
+	}
+
+	if(!_watching())
+	{
+		return __memalign(alignment, size);
+	}
+
 	_mask(SHIFT_memalign);
+	_account(size);
+
+	void *ptr = __memalign(alignment, size);
+
+	_track(ptr, size);
 
-	return __memalign(alignment, size);
+	return ptr;
 }
 
 void *
 pvalloc(size_t size)
 {
+	if(!_ready())
+	{
+		const size_t page = getpagesize();
+
+		if(size > BOOTSTRAP_SIZE) // would wrap around when rounded up
+		{
+			errno = ENOMEM;
+			return NULL;
+		}
+
+		return _bootstrap_alloc(page, (size + page - 1) & ~(page - 1));
+	}
+
+	if(!_watching())
+	{
+		return __pvalloc(size);
+	}
+
 	_mask(SHIFT_pvalloc);
+	_account(size);
 
-	return __pvalloc(size);
+	void *ptr = __pvalloc(size);
+
+	_track(ptr, size);
+
+	return ptr;
 }
 
 /* FIXME
@@ -193,6 +734,7 @@ malloc_usable_size
 int
 pthread_mutex_lock(pthread_mutex_t *mutex)
 {
+	_ready();
 	_mask(SHIFT_pthread_mutex_lock);
 
 	return __pthread_mutex_lock(mutex);
@@ -201,6 +743,7 @@ pthread_mutex_lock(pthread_mutex_t *mutex)
 int
 pthread_mutex_unlock(pthread_mutex_t *mutex)
 {
+	_ready();
 	_mask(SHIFT_pthread_mutex_unlock);
 
 	return __pthread_mutex_unlock(mutex);
@@ -209,6 +752,7 @@ pthread_mutex_unlock(pthread_mutex_t *mutex)
 int
 pthread_mutex_timedlock(pthread_mutex_t *mutex, const struct timespec *abstime)
 {
+	_ready();
 	_mask(SHIFT_pthread_mutex_timedlock);
 
 	return __pthread_mutex_timedlock(mutex, abstime);
@@ -217,6 +761,7 @@ pthread_mutex_timedlock(pthread_mutex_t *mutex, const struct timespec *abstime)
 int
 sem_wait(sem_t *sem)
 {
+	_ready();
 	_mask(SHIFT_sem_wait);
 
 	return __sem_wait(sem);
@@ -225,6 +770,7 @@ sem_wait(sem_t *sem)
 int
 sem_timedwait(sem_t *sem, const struct timespec *abstime)
 {
+	_ready();
 	_mask(SHIFT_sem_timedwait);
 
 	return __sem_timedwait(sem, abstime);
@@ -233,6 +779,7 @@ sem_timedwait(sem_t *sem, const struct timespec *abstime)
 unsigned
 sleep(unsigned secs)
 {
+	_ready();
 	_mask(SHIFT_sleep);
 
 	return __sleep(secs);
@@ -241,6 +788,7 @@ sleep(unsigned secs)
 int
 usleep(useconds_t usecs)
 {
+	_ready();
 	_mask(SHIFT_usleep);
 
 	return __usleep(usecs);
@@ -249,6 +797,7 @@ usleep(useconds_t usecs)
 int
 nanosleep(const struct timespec *rqtp, struct timespec *rmtp)
 {
+	_ready();
 	_mask(SHIFT_nanosleep);
 
 	return __nanosleep(rqtp, rmtp);
@@ -258,7 +807,414 @@ int
 clock_nanosleep(clockid_t clock, int flags, const struct timespec *rqtp,
 	struct timespec *rmtp)
 {
+	_ready();
 	_mask(SHIFT_clock_nanosleep);
 
 	return __clock_nanosleep(clock, flags, rqtp, rmtp);
 }
+
+// libm and libatomic may only be loaded together with the plugin into its
+// local scope, thus resolve on first use and look into the loaded library, too
+static bool
+_resolve(dict_t *dict, const char *soname)
+{
+	if(*(dict->func))
+	{
+		return true;
+	}
+
+	if(dict->missing)
+	{
+		return false;
+	}
+
+	resolving = true; // dlsym and dlopen may allocate, do not blame the plugin
+
+	*(dict->func) = dlsym(RTLD_NEXT, dict->name);
+
+	if(*(dict->func) == NULL)
+	{
+		void *lib = dlopen(soname, RTLD_LAZY | RTLD_NOLOAD);
+
+		if(lib)
+		{
+			*(dict->func) = dlsym(lib, dict->name);
+			dlclose(lib);
+		}
+	}
+
+	resolving = false;
+
+	if(*(dict->func) == NULL)
+	{
+		fprintf(stderr, "Error in dlsym(%s, %s): %s\n",
+			soname, dict->name, dlerror());
+		dict->missing = true;
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Without libatomic in the process, the generic entry points fall back to the
+ * builtins for sizes the compiler handles lock-free and to a single lock for
+ * all other sizes, like libatomic's own lock table does, just coarser.
+ */
+static atomic_flag fallback_lock = ATOMIC_FLAG_INIT;
+
+static inline void
+_fallback_lock(void)
+{
+	while(atomic_flag_test_and_set_explicit(&fallback_lock, memory_order_acquire))
+	{
+		// spin
+	}
+}
+
+static inline void
+_fallback_unlock(void)
+{
+	atomic_flag_clear_explicit(&fallback_lock, memory_order_release);
+}
+
+static void
+_fallback_load(size_t size, void *mem, void *ret, int model)
+{
+	switch(size)
+	{
+		case 1:
+			*(uint8_t *)ret = __atomic_load_n((uint8_t *)mem, model);
+			return;
+		case 2:
+			*(uint16_t *)ret = __atomic_load_n((uint16_t *)mem, model);
+			return;
+		case 4:
+			*(uint32_t *)ret = __atomic_load_n((uint32_t *)mem, model);
+			return;
+		case 8:
+			*(uint64_t *)ret = __atomic_load_n((uint64_t *)mem, model);
+			return;
+	}
+
+	_fallback_lock();
+	memcpy(ret, mem, size);
+	_fallback_unlock();
+}
+
+static void
+_fallback_store(size_t size, void *mem, void *val, int model)
+{
+	switch(size)
+	{
+		case 1:
+			__atomic_store_n((uint8_t *)mem, *(uint8_t *)val, model);
+			return;
+		case 2:
+			__atomic_store_n((uint16_t *)mem, *(uint16_t *)val, model);
+			return;
+		case 4:
+			__atomic_store_n((uint32_t *)mem, *(uint32_t *)val, model);
+			return;
+		case 8:
+			__atomic_store_n((uint64_t *)mem, *(uint64_t *)val, model);
+			return;
+	}
+
+	_fallback_lock();
+	memcpy(mem, val, size);
+	_fallback_unlock();
+}
+
+static void
+_fallback_exchange(size_t size, void *mem, void *val, void *ret, int model)
+{
+	switch(size)
+	{
+		case 1:
+			*(uint8_t *)ret = __atomic_exchange_n((uint8_t *)mem, *(uint8_t *)val,
+				model);
+			return;
+		case 2:
+			*(uint16_t *)ret = __atomic_exchange_n((uint16_t *)mem, *(uint16_t *)val,
+				model);
+			return;
+		case 4:
+			*(uint32_t *)ret = __atomic_exchange_n((uint32_t *)mem, *(uint32_t *)val,
+				model);
+			return;
+		case 8:
+			*(uint64_t *)ret = __atomic_exchange_n((uint64_t *)mem, *(uint64_t *)val,
+				model);
+			return;
+	}
+
+	_fallback_lock();
+	memcpy(ret, mem, size);
+	memcpy(mem, val, size);
+	_fallback_unlock();
+}
+
+static bool
+_fallback_compare_exchange(size_t size, void *mem, void *expected,
+	void *desired, int success, int failure)
+{
+	switch(size)
+	{
+		case 1:
+			return __atomic_compare_exchange_n((uint8_t *)mem, (uint8_t *)expected,
+				*(uint8_t *)desired, false, success, failure);
+		case 2:
+			return __atomic_compare_exchange_n((uint16_t *)mem, (uint16_t *)expected,
+				*(uint16_t *)desired, false, success, failure);
+		case 4:
+			return __atomic_compare_exchange_n((uint32_t *)mem, (uint32_t *)expected,
+				*(uint32_t *)desired, false, success, failure);
+		case 8:
+			return __atomic_compare_exchange_n((uint64_t *)mem, (uint64_t *)expected,
+				*(uint64_t *)desired, false, success, failure);
+	}
+
+	_fallback_lock();
+	const bool equal = memcmp(mem, expected, size) == 0;
+	if(equal)
+	{
+		memcpy(mem, desired, size);
+	}
+	else
+	{
+		memcpy(expected, mem, size);
+	}
+	_fallback_unlock();
+
+	return equal;
+}
+
+void
+_atomic_load(size_t size, void *mem, void *ret, int model)
+	__asm__("__atomic_load");
+
+void
+_atomic_load(size_t size, void *mem, void *ret, int model)
+{
+	_ready();
+	_mask(SHIFT_atomic_load);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_load], LIBATOMIC_SONAME))
+	{
+		_fallback_load(size, mem, ret, model);
+		return;
+	}
+
+	__libatomic_load(size, mem, ret, model);
+}
+
+void
+_atomic_store(size_t size, void *mem, void *val, int model)
+	__asm__("__atomic_store");
+
+void
+_atomic_store(size_t size, void *mem, void *val, int model)
+{
+	_ready();
+	_mask(SHIFT_atomic_store);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_store], LIBATOMIC_SONAME))
+	{
+		_fallback_store(size, mem, val, model);
+		return;
+	}
+
+	__libatomic_store(size, mem, val, model);
+}
+
+void
+_atomic_exchange(size_t size, void *mem, void *val, void *ret, int model)
+	__asm__("__atomic_exchange");
+
+void
+_atomic_exchange(size_t size, void *mem, void *val, void *ret, int model)
+{
+	_ready();
+	_mask(SHIFT_atomic_exchange);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_exchange], LIBATOMIC_SONAME))
+	{
+		_fallback_exchange(size, mem, val, ret, model);
+		return;
+	}
+
+	__libatomic_exchange(size, mem, val, ret, model);
+}
+
+bool
+_atomic_compare_exchange(size_t size, void *mem, void *expected, void *desired,
+	int success, int failure)
+	__asm__("__atomic_compare_exchange");
+
+bool
+_atomic_compare_exchange(size_t size, void *mem, void *expected, void *desired,
+	int success, int failure)
+{
+	_ready();
+	_mask(SHIFT_atomic_compare_exchange);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_compare_exchange], LIBATOMIC_SONAME))
+	{
+		return _fallback_compare_exchange(size, mem, expected, desired,
+			success, failure);
+	}
+
+	return __libatomic_compare_exchange(size, mem, expected, desired,
+		success, failure);
+}
+
+#ifdef __SIZEOF_INT128__
+atomic_16_t
+_atomic_load_16(const volatile void *mem, int model)
+	__asm__("__atomic_load_16");
+
+atomic_16_t
+_atomic_load_16(const volatile void *mem, int model)
+{
+	_ready();
+	_mask(SHIFT_atomic_load_16);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_load_16], LIBATOMIC_SONAME))
+	{
+		atomic_16_t ret;
+
+		_fallback_load(sizeof(ret), (void *)mem, &ret, model);
+
+		return ret;
+	}
+
+	return __libatomic_load_16(mem, model);
+}
+
+void
+_atomic_store_16(volatile void *mem, atomic_16_t val, int model)
+	__asm__("__atomic_store_16");
+
+void
+_atomic_store_16(volatile void *mem, atomic_16_t val, int model)
+{
+	_ready();
+	_mask(SHIFT_atomic_store_16);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_store_16], LIBATOMIC_SONAME))
+	{
+		_fallback_store(sizeof(val), (void *)mem, &val, model);
+		return;
+	}
+
+	__libatomic_store_16(mem, val, model);
+}
+
+atomic_16_t
+_atomic_exchange_16(volatile void *mem, atomic_16_t val, int model)
+	__asm__("__atomic_exchange_16");
+
+atomic_16_t
+_atomic_exchange_16(volatile void *mem, atomic_16_t val, int model)
+{
+	_ready();
+	_mask(SHIFT_atomic_exchange_16);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_exchange_16], LIBATOMIC_SONAME))
+	{
+		atomic_16_t ret;
+
+		_fallback_exchange(sizeof(val), (void *)mem, &val, &ret, model);
+
+		return ret;
+	}
+
+	return __libatomic_exchange_16(mem, val, model);
+}
+
+bool
+_atomic_compare_exchange_16(volatile void *mem, atomic_16_t *expected,
+	atomic_16_t desired, bool weak, int success, int failure)
+	__asm__("__atomic_compare_exchange_16");
+
+bool
+_atomic_compare_exchange_16(volatile void *mem, atomic_16_t *expected,
+	atomic_16_t desired, bool weak, int success, int failure)
+{
+	_ready();
+	_mask(SHIFT_atomic_compare_exchange_16);
+
+	if(!_resolve(&atomic_dicts[SHIFT_atomic_compare_exchange_16],
+		LIBATOMIC_SONAME))
+	{
+		return _fallback_compare_exchange(sizeof(desired), (void *)mem, expected,
+			&desired, success, failure);
+	}
+
+	return __libatomic_compare_exchange_16(mem, expected, desired, weak,
+		success, failure);
+}
+#endif
+
+#ifdef ENABLE_LIBM_TESTS
+static inline void
+_count(libm_t libm)
+{
+	_ready();
+
+	if(!_resolve(&libm_dicts[libm], LIBM_SONAME))
+	{
+		abort(); // cannot happen, the caller is linked against libm
+	}
+
+	if(!_watching() || !shm_enabled(shm))
+	{
+		return;
+	}
+
+	shm->libm[libm]++;
+}
+
+#define LIBM_UNARY(TYPE, NAME) \
+	TYPE \
+	NAME(TYPE x) \
+	{ \
+		_count(LIBM_ ## NAME); \
+		\
+		return __ ## NAME(x); \
+	}
+
+#define LIBM_BINARY(TYPE, NAME) \
+	TYPE \
+	NAME(TYPE x, TYPE y) \
+	{ \
+		_count(LIBM_ ## NAME); \
+		\
+		return __ ## NAME(x, y); \
+	}
+
+LIBM_BINARY(float, powf)
+LIBM_BINARY(double, pow)
+LIBM_UNARY(float, expf)
+LIBM_UNARY(double, exp)
+LIBM_UNARY(float, exp2f)
+LIBM_UNARY(double, exp2)
+LIBM_UNARY(float, logf)
+LIBM_UNARY(double, log)
+LIBM_UNARY(float, log2f)
+LIBM_UNARY(double, log2)
+LIBM_UNARY(float, log10f)
+LIBM_UNARY(double, log10)
+LIBM_UNARY(float, sinf)
+LIBM_UNARY(double, sin)
+LIBM_UNARY(float, cosf)
+LIBM_UNARY(double, cos)
+LIBM_UNARY(float, tanf)
+LIBM_UNARY(double, tan)
+LIBM_UNARY(float, tanhf)
+LIBM_UNARY(double, tanh)
+LIBM_BINARY(float, atan2f)
+LIBM_BINARY(double, atan2)
+#endif
@@ -0,0 +1,259 @@
+/*
+ * SPDX-FileCopyrightText: Hanspeter Portner <dev@open-music-kontrollers.ch>
+ * SPDX-License-Identifier: Artistic-2.0
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include <lv2lint/lv2lint.h>
+
+#define POOL_ALIGN 16
+#define POOL_MAX_CHUNKS 0x10000
+
+typedef struct _mempool_t mempool_t;
+
+struct _mempool_t {
+	size_t size;
+	size_t stride;
+	uint32_t nchunks;
+	atomic_uint_fast64_t head; // ABA tag in upper, chunk index + 1 in lower half
+	uint32_t *next;
+	uint8_t *chunks;
+};
+
+// the rtmempool feature carries no host handle, thus keep track of it here
+static app_t *pool_app = NULL;
+
+static inline phase_t
+_phase(void)
+{
+	return pool_app->shm->phase;
+}
+
+// the pool's own allocations are the host's, not the plugin's
+static inline bool
+_pause(void)
+{
+	return shm_pause(pool_app->shm);
+}
+
+static inline void
+_resume(bool paused)
+{
+	if(!paused)
+	{
+		shm_resume(pool_app->shm);
+	}
+}
+
+static inline bool
+_is_chunk(mempool_t *mempool, const void *ptr)
+{
+	return ((const uint8_t *)ptr >= mempool->chunks)
+		&& ((const uint8_t *)ptr < &mempool->chunks[mempool->nchunks * mempool->stride]);
+}
+
+static void *
+_pop(mempool_t *mempool)
+{
+	uint_fast64_t head = atomic_load_explicit(&mempool->head, memory_order_acquire);
+
+	while(true)
+	{
+		const uint32_t idx = head & UINT32_MAX;
+
+		if(idx == 0) // exhausted
+		{
+			return NULL;
+		}
+
+		const uint_fast64_t tag = (head >> 32) + 1;
+		const uint_fast64_t next = (tag << 32) | mempool->next[idx - 1];
+
+		if(atomic_compare_exchange_weak_explicit(&mempool->head, &head, next,
+			memory_order_acq_rel, memory_order_acquire))
+		{
+			return &mempool->chunks[(idx - 1) * mempool->stride];
+		}
+	}
+}
+
+static void
+_push(mempool_t *mempool, void *ptr)
+{
+	const uint32_t idx = ((uint8_t *)ptr - mempool->chunks) / mempool->stride + 1;
+	uint_fast64_t head = atomic_load_explicit(&mempool->head, memory_order_acquire);
+	uint_fast64_t next;
+
+	do
+	{
+		mempool->next[idx - 1] = head & UINT32_MAX;
+		next = (((head >> 32) + 1) << 32) | idx;
+	} while(!atomic_compare_exchange_weak_explicit(&mempool->head, &head, next,
+		memory_order_acq_rel, memory_order_acquire));
+}
+
+static void
+_account(mempool_t *mempool, void *ptr)
+{
+	const phase_t phase = _phase();
+
+	if(ptr)
+	{
+		pool_app->pool.usage[phase].count++;
+		pool_app->pool.usage[phase].bytes += mempool->size;
+	}
+	else
+	{
+		pool_app->pool.failed[phase]++;
+	}
+}
+
+static bool
+_create(LV2_RtMemPool_Handle *handle_ptr, const char *pool_name __attribute__((unused)),
+	size_t data_size, size_t min_preallocated, size_t max_preallocated)
+{
+	pool_app->pool.sleepy[_phase()]++;
+
+	const bool paused = _pause();
+
+	mempool_t *mempool = calloc(1, sizeof(mempool_t));
+	if(!mempool)
+	{
+		_resume(paused);
+		return false;
+	}
+
+	size_t nchunks = max_preallocated > min_preallocated
+		? max_preallocated
+		: min_preallocated;
+
+	if(nchunks > POOL_MAX_CHUNKS)
+	{
+		nchunks = POOL_MAX_CHUNKS;
+	}
+	else if(nchunks == 0)
+	{
+		nchunks = 1;
+	}
+
+	mempool->size = data_size;
+	mempool->stride = (data_size + POOL_ALIGN - 1) & ~(POOL_ALIGN - 1);
+	mempool->nchunks = nchunks;
+	mempool->next = calloc(nchunks, sizeof(uint32_t));
+	mempool->chunks = aligned_alloc(POOL_ALIGN, nchunks * mempool->stride);
+
+	if(!mempool->next || !mempool->chunks)
+	{
+		free(mempool->next);
+		free(mempool->chunks);
+		free(mempool);
+		_resume(paused);
+		return false;
+	}
+
+	memset(mempool->chunks, 0x0, nchunks * mempool->stride); // prefault
+
+	// chain all chunks into the free list
+	for(uint32_t i = 0; i < nchunks; i++)
+	{
+		mempool->next[i] = (i + 1 < nchunks) ? i + 2 : 0;
+	}
+
+	atomic_init(&mempool->head, 1);
+
+	_resume(paused);
+
+	*handle_ptr = mempool;
+
+	return true;
+}
+
+static void
+_destroy(LV2_RtMemPool_Handle handle)
+{
+	mempool_t *mempool = handle;
+
+	pool_app->pool.sleepy[_phase()]++;
+
+	const bool paused = _pause();
+
+	free(mempool->next);
+	free(mempool->chunks);
+	free(mempool);
+
+	_resume(paused);
+}
+
+static void *
+_allocate_atomic(LV2_RtMemPool_Handle handle)
+{
+	mempool_t *mempool = handle;
+
+	void *ptr = _pop(mempool);
+
+	_account(mempool, ptr);
+
+	return ptr;
+}
+
+static void *
+_allocate_sleepy(LV2_RtMemPool_Handle handle)
+{
+	mempool_t *mempool = handle;
+
+	pool_app->pool.sleepy[_phase()]++;
+
+	void *ptr = _pop(mempool);
+
+	_account(mempool, ptr);
+
+	if(!ptr) // may sleep, thus fall back to the system heap
+	{
+		const bool paused = _pause();
+
+		ptr = aligned_alloc(POOL_ALIGN, mempool->stride);
+
+		_resume(paused);
+	}
+
+	return ptr;
+}
+
+static void
+_deallocate(LV2_RtMemPool_Handle handle, void *memory_ptr)
+{
+	mempool_t *mempool = handle;
+
+	if(!memory_ptr)
+	{
+		return;
+	}
+
+	if(_is_chunk(mempool, memory_ptr))
+	{
+		_push(mempool, memory_ptr);
+	}
+	else
+	{
+		const bool paused = _pause();
+
+		free(memory_ptr);
+
+		_resume(paused);
+	}
+}
+
+void
+lv2lint_mempool_init(app_t *app, LV2_RtMemPool_Pool *pool)
+{
+	pool_app = app;
+
+	pool->create = _create;
+	pool->destroy = _destroy;
+	pool->allocate_atomic = _allocate_atomic;
+	pool->allocate_sleepy = _allocate_sleepy;
+	pool->deallocate = _deallocate;
+}
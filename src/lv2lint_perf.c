@@ -0,0 +1,3027 @@
+/*
+ * SPDX-FileCopyrightText: Hanspeter Portner <dev@open-music-kontrollers.ch>
+ * SPDX-License-Identifier: Artistic-2.0
+ */
+
+#include <time.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <dirent.h>
+#include <malloc.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/prctl.h>
+#include <linux/perf_event.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+
+#include <lv2lint/lv2lint.h>
+
+#define PERF_WARMUP 16 // blocks run before measuring
+#define PERF_AMPLITUDE 0.5f
+#define PERF_FREQUENCY 440.0
+#define PERF_SEED 0x12345678
+#define DENORMAL_TAIL 4 // tail duration relative to burst duration
+#define DENORMAL_WINDOW 16 // blocks per median in the tail, robust to preemption
+#define BLOCK_RANDOM 256 // randomly sized run() calls
+#define BLOCK_REPEAT 256 // run() calls per size to estimate fixed overhead
+#define BLOCK_CANARY 0x7fa5a5a5 // signalling NaN painted past n_samples
+#define INPLACE_BLOCKS 64 // compared without --dsp-load, enough to catch breakage
+#define MISALIGN_ALIGN 64 // alignment of scratch buffers before offsetting
+#define MISALIGN_BLOCKS 64 // compared without --dsp-load
+#define PROFILE_INTERVAL 1000 // us of CPU time between samples
+#define PROFILE_DURATION 10 // s of wall-clock time at most
+#define SCALING_MAX 256 // concurrent instances at most
+#define SCALING_RECORD 16 // final blocks compared across instances
+#define SCALING_ALIGN 64 // cache line
+#define CYCLE_SAMPLE 16 // cycles between resource samples
+#define CYCLE_SAMPLES (CYCLE_COUNT / CYCLE_SAMPLE)
+#define LEAK_SITES 256 // distinct allocation sites aggregated at most
+#define COLD_FACTOR 2 // eviction buffer relative to the largest cache
+#define COLD_FALLBACK (32ULL << 20) // bytes evicted if the cache size is unknown
+#define COLD_LINE 64 // bytes, stride of the eviction stream
+#define DENSITY_BUDGET (1ULL << 30) // bytes of growth before giving up on more instances
+
+typedef enum _kind_t {
+	KIND_NONE = 0,
+	KIND_SIGNAL, // audio or CV input
+	KIND_OUTPUT, // audio or CV output
+	KIND_SEQUENCE, // atom output
+	KIND_CONTROL // control input
+} kind_t;
+
+typedef struct _perf_t perf_t;
+
+struct _perf_t {
+	app_t *app;
+	LilvInstance *instance;
+	buf_t *bufs;
+	uint32_t nports;
+	kind_t *kinds;
+	float **wav; // connected signal buffers
+	float *ctrl; // control input values to restore
+	uint32_t nsamples; // per block
+	uint32_t nout;
+	uint32_t seed;
+	double phase;
+};
+
+static inline uint64_t
+_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int
+_cmp(const void *a, const void *b)
+{
+	const uint64_t *A = a;
+	const uint64_t *B = b;
+
+	return (*A > *B) - (*A < *B);
+}
+
+static inline uint64_t
+_percentile(const uint64_t *sorted, uint32_t n, double p)
+{
+	return sorted[(uint32_t)(p * (n - 1) + 0.5)];
+}
+
+static bool
+_perf_init(perf_t *perf, app_t *app, buf_t *bufs)
+{
+	perf->app = app;
+	perf->instance = app->instance;
+	perf->bufs = bufs;
+	perf->nports = app->nbufs;
+	perf->nsamples = app->dsp.nsamples;
+	perf->seed = PERF_SEED;
+	perf->phase = 0.0;
+	perf->nout = 0;
+
+	if(!bufs)
+	{
+		return false;
+	}
+
+	perf->kinds = calloc(perf->nports, sizeof(kind_t));
+	perf->wav = calloc(perf->nports, sizeof(float *));
+	perf->ctrl = calloc(perf->nports, sizeof(float));
+	if(!perf->kinds || !perf->wav || !perf->ctrl)
+	{
+		free(perf->kinds);
+		free(perf->wav);
+		free(perf->ctrl);
+		return false;
+	}
+
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		const LilvPort *port = lilv_plugin_get_port_by_index(app->plugin, p);
+		const bool is_input = lilv_port_is_a(app->plugin, port,
+			NODE(app, CORE__InputPort));
+
+		const bool is_signal = lilv_port_is_a(app->plugin, port,
+				NODE(app, CORE__AudioPort))
+			|| lilv_port_is_a(app->plugin, port, NODE(app, CORE__CVPort));
+
+		if(is_signal)
+		{
+			perf->kinds[p] = is_input ? KIND_SIGNAL : KIND_OUTPUT;
+			perf->wav[p] = bufs[p].port->wav;
+
+			if(!is_input)
+			{
+				perf->nout++;
+			}
+		}
+		else if(lilv_port_is_a(app->plugin, port, NODE(app, ATOM__AtomPort))
+			&& !is_input)
+		{
+			perf->kinds[p] = KIND_SEQUENCE;
+		}
+		else if(lilv_port_is_a(app->plugin, port, NODE(app, CORE__ControlPort))
+			&& is_input)
+		{
+			LilvNode *def = NULL;
+
+			// the conformance tests after the benchmarks see the values of before
+			perf->kinds[p] = KIND_CONTROL;
+			perf->ctrl[p] = bufs[p].port->wav[0];
+
+			// measure at default settings rather than all-zero controls
+			lilv_port_get_range(app->plugin, port, &def, NULL, NULL);
+
+			if(def)
+			{
+				if(lilv_node_is_float(def) || lilv_node_is_int(def))
+				{
+					bufs[p].port->wav[0] = lilv_node_as_float(def);
+				}
+
+				lilv_node_free(def);
+			}
+		}
+	}
+
+	return true;
+}
+
+static void
+_perf_deinit(perf_t *perf)
+{
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		if(perf->kinds[p] == KIND_CONTROL)
+		{
+			perf->bufs[p].port->wav[0] = perf->ctrl[p];
+		}
+	}
+
+	free(perf->kinds);
+	free(perf->wav);
+	free(perf->ctrl);
+}
+
+static void
+_perf_fill(perf_t *perf, stim_t stim)
+{
+	const double inc = 2.0 * M_PI * PERF_FREQUENCY / perf->app->sample_rate;
+
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		buf_t *buf = &perf->bufs[p];
+
+		switch(perf->kinds[p])
+		{
+			case KIND_SIGNAL:
+			{
+				float *wav = perf->wav[p];
+				double phase = perf->phase;
+
+				for(uint32_t i = 0; i < perf->nsamples; i++)
+				{
+					switch(stim)
+					{
+						case STIM_silence:
+						{
+							wav[i] = 0.f;
+						}	break;
+						case STIM_noise:
+						{
+							// xorshift32
+							perf->seed ^= perf->seed << 13;
+							perf->seed ^= perf->seed >> 17;
+							perf->seed ^= perf->seed << 5;
+
+							wav[i] = PERF_AMPLITUDE
+								* ( (float)perf->seed / (float)UINT32_MAX * 2.f - 1.f);
+						}	break;
+						case STIM_sine:
+						{
+							wav[i] = PERF_AMPLITUDE * sin(phase);
+							phase += inc;
+						}	break;
+						case STIM_MAX:
+						{
+							// nothing
+						}	break;
+					}
+				}
+			}	break;
+			case KIND_SEQUENCE:
+			{
+				buf->port->seq.atom.size = buf->size - sizeof(LV2_Atom); // reset capacity
+			}	break;
+			case KIND_OUTPUT:
+			case KIND_CONTROL:
+			case KIND_NONE:
+			{
+				// nothing
+			}	break;
+		}
+	}
+
+	perf->phase = fmod(perf->phase + inc * perf->nsamples, 2.0 * M_PI);
+}
+
+static uint64_t
+_perf_time(perf_t *perf, uint32_t nsamples)
+{
+	const uint64_t t0 = _now();
+
+	lilv_instance_run(perf->instance, nsamples);
+
+	return _now() - t0;
+}
+
+static uint64_t
+_perf_run(perf_t *perf, stim_t stim)
+{
+	_perf_fill(perf, stim);
+
+	return _perf_time(perf, perf->nsamples);
+}
+
+int
+lv2lint_perf_dsp(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	const uint32_t nblocks = app->dsp.duration * app->sample_rate
+		/ app->dsp.nsamples;
+
+	if(nblocks == 0)
+	{
+		return 0;
+	}
+
+	uint64_t *ns = calloc(nblocks, sizeof(uint64_t));
+	if(!ns)
+	{
+		return 0;
+	}
+
+	if(!_perf_init(&perf, app, bufs))
+	{
+		free(ns);
+		return 0;
+	}
+
+	for(stim_t stim = 0; stim < STIM_MAX; stim++)
+	{
+		dsp_t *dsp = &app->dsp.stim[stim];
+		double sum = 0.0;
+
+		for(uint32_t i = 0; i < PERF_WARMUP; i++)
+		{
+			_perf_run(&perf, stim);
+		}
+
+		for(uint32_t i = 0; i < nblocks; i++)
+		{
+			ns[i] = _perf_run(&perf, stim);
+			sum += ns[i];
+		}
+
+		qsort(ns, nblocks, sizeof(uint64_t), _cmp);
+
+		dsp->mean = sum / nblocks / app->dsp.nsamples;
+		dsp->p50 = (double)_percentile(ns, nblocks, 0.50) / app->dsp.nsamples;
+		dsp->p99 = (double)_percentile(ns, nblocks, 0.99) / app->dsp.nsamples;
+		dsp->max = (double)ns[nblocks - 1] / app->dsp.nsamples;
+		dsp->valid = true;
+	}
+
+	_perf_deinit(&perf);
+	free(ns);
+
+	return 0;
+}
+
+static inline uint32_t
+_jitter_bin(uint64_t ns)
+{
+	const uint32_t bin = ns ? log2(ns) * JITTER_SUB : 0;
+
+	return bin < JITTER_BINS ? bin : JITTER_BINS - 1;
+}
+
+int
+lv2lint_perf_jitter(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	if(!app->jitter.blocks || !_perf_init(&perf, app, bufs))
+	{
+		return 0;
+	}
+
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	for(uint32_t i = 0; i < app->jitter.blocks; i++)
+	{
+		const uint64_t ns = _perf_run(&perf, STIM_noise);
+
+		app->jitter.bins[_jitter_bin(ns)]++;
+
+		if(ns > app->jitter.max)
+		{
+			app->jitter.max = ns;
+		}
+	}
+
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+// branch-free, so the compiler can vectorise it
+static uint32_t
+_subnormals(const float *wav, uint32_t nsamples)
+{
+	uint32_t count = 0;
+
+	for(uint32_t i = 0; i < nsamples; i++)
+	{
+		uint32_t bits;
+
+		memcpy(&bits, &wav[i], sizeof(bits));
+
+		count += ( (bits & 0x7f800000) == 0) & ( (bits & 0x007fffff) != 0);
+	}
+
+	return count;
+}
+
+static uint32_t
+_perf_subnormals(perf_t *perf)
+{
+	uint32_t count = 0;
+
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		if(perf->kinds[p] == KIND_OUTPUT)
+		{
+			count += _subnormals(perf->wav[p], perf->nsamples);
+		}
+	}
+
+	return count;
+}
+
+int
+lv2lint_perf_denormal(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	const uint32_t nburst = app->dsp.duration * app->sample_rate
+		/ app->dsp.nsamples;
+	const uint32_t ntail = nburst * DENORMAL_TAIL;
+
+	if( (nburst == 0) || (ntail < DENORMAL_WINDOW) )
+	{
+		return 0;
+	}
+
+	uint64_t *ns = calloc(ntail, sizeof(uint64_t));
+	if(!ns)
+	{
+		return 0;
+	}
+
+	if(!_perf_init(&perf, app, bufs))
+	{
+		free(ns);
+		return 0;
+	}
+
+	// steady state on a noise burst
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	for(uint32_t i = 0; i < nburst; i++)
+	{
+		ns[i] = _perf_run(&perf, STIM_noise);
+	}
+
+	qsort(ns, nburst, sizeof(uint64_t), _cmp);
+	app->denormal.steady = (double)_percentile(ns, nburst, 0.50)
+		/ app->dsp.nsamples;
+
+	// decaying tail on silence
+	for(uint32_t i = 0; i < ntail; i++)
+	{
+		ns[i] = _perf_run(&perf, STIM_silence);
+
+		app->denormal.subnormals += _perf_subnormals(&perf);
+	}
+
+	for(uint32_t i = 0; i + DENORMAL_WINDOW <= ntail; i += DENORMAL_WINDOW)
+	{
+		uint64_t *window = &ns[i];
+
+		qsort(window, DENORMAL_WINDOW, sizeof(uint64_t), _cmp);
+
+		const double tail = (double)_percentile(window, DENORMAL_WINDOW, 0.50)
+			/ app->dsp.nsamples;
+
+		if(tail > app->denormal.tail)
+		{
+			app->denormal.tail = tail;
+			app->denormal.onset = (double)i * app->dsp.nsamples / app->sample_rate;
+		}
+	}
+
+	app->denormal.valid = true;
+
+	_perf_deinit(&perf);
+	free(ns);
+
+	return 0;
+}
+
+static bool
+_block_allowed(app_t *app, uint32_t nsamples)
+{
+	if(nsamples > app->block.max)
+	{
+		return false;
+	}
+
+	if(app->block.fixed)
+	{
+		return nsamples == app->block.max;
+	}
+
+	if(app->block.pow2)
+	{
+		return nsamples && !(nsamples & (nsamples - 1))
+			&& (nsamples >= app->block.min);
+	}
+
+	if(nsamples == 0)
+	{
+		return app->block.min == 0;
+	}
+
+	return nsamples >= app->block.min;
+}
+
+static uint32_t
+_block_random(perf_t *perf)
+{
+	app_t *app = perf->app;
+
+	// xorshift32
+	perf->seed ^= perf->seed << 13;
+	perf->seed ^= perf->seed >> 17;
+	perf->seed ^= perf->seed << 5;
+
+	if(app->block.fixed)
+	{
+		return app->block.max;
+	}
+
+	const uint32_t min = app->block.min ? app->block.min : 1;
+
+	if(app->block.pow2)
+	{
+		uint32_t nsamples = 1U << (perf->seed % 32);
+
+		while(nsamples > app->block.max)
+		{
+			nsamples >>= 1;
+		}
+
+		return nsamples >= min ? nsamples : app->block.max;
+	}
+
+	return min + perf->seed % (app->block.max - min + 1);
+}
+
+// paint output samples past n_samples, which the plugin must not touch
+static void
+_block_paint(perf_t *perf, uint32_t nsamples)
+{
+	const uint32_t canary = BLOCK_CANARY;
+
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		if(perf->kinds[p] == KIND_OUTPUT)
+		{
+			for(uint32_t i = nsamples; i < perf->nsamples; i++)
+			{
+				memcpy(&perf->wav[p][i], &canary, sizeof(canary));
+			}
+		}
+	}
+}
+
+static bool
+_block_overrun(perf_t *perf, uint32_t nsamples)
+{
+	const uint32_t canary = BLOCK_CANARY;
+
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		if(perf->kinds[p] == KIND_OUTPUT)
+		{
+			for(uint32_t i = nsamples; i < perf->nsamples; i++)
+			{
+				if(memcmp(&perf->wav[p][i], &canary, sizeof(canary)))
+				{
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+static void
+_block_run(perf_t *perf, uint32_t nsamples)
+{
+	app_t *app = perf->app;
+
+	_perf_fill(perf, STIM_noise);
+	_block_paint(perf, nsamples);
+
+	lilv_instance_run(app->instance, nsamples);
+
+	app->block.calls++;
+
+	if(_block_overrun(perf, nsamples))
+	{
+		if(!app->block.overruns++)
+		{
+			app->block.overrun = nsamples;
+		}
+	}
+}
+
+static double
+_block_median(perf_t *perf, uint64_t *ns, uint32_t nsamples)
+{
+	for(uint32_t i = 0; i < BLOCK_REPEAT; i++)
+	{
+		_perf_fill(perf, STIM_noise);
+		ns[i] = _perf_time(perf, nsamples);
+	}
+
+	qsort(ns, BLOCK_REPEAT, sizeof(uint64_t), _cmp);
+
+	return _percentile(ns, BLOCK_REPEAT, 0.50);
+}
+
+int
+lv2lint_perf_block(app_t *app, void *data)
+{
+	const uint32_t sizes [] = {
+		0, 1, 2, 3, 5, 7, 13, 31, 61, 127, 251, app->block.max
+	};
+	const uint32_t nsizes = sizeof(sizes) / sizeof(uint32_t);
+	buf_t *bufs = data;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	uint64_t *ns = calloc(BLOCK_REPEAT, sizeof(uint64_t));
+	if(!ns)
+	{
+		return 0;
+	}
+
+	if(!_perf_init(&perf, app, bufs))
+	{
+		free(ns);
+		return 0;
+	}
+
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	// adversarial sizes, then randomly varying ones, all within one activation
+	for(uint32_t i = 0; i < nsizes; i++)
+	{
+		if(_block_allowed(app, sizes[i]))
+		{
+			_block_run(&perf, sizes[i]);
+		}
+	}
+
+	for(uint32_t i = 0; i < BLOCK_RANDOM; i++)
+	{
+		_block_run(&perf, _block_random(&perf));
+	}
+
+	// fixed overhead from a linear fit through smallest and largest block,
+	// timed with the other DSP benchmarks only
+	uint32_t small = 1;
+
+	while( (small < app->block.max) && !_block_allowed(app, small) )
+	{
+		small++;
+	}
+
+	if(app->dsp.enabled && (small < app->block.max) )
+	{
+		const double t_small = _block_median(&perf, ns, small);
+		const double t_max = _block_median(&perf, ns, app->block.max);
+		const double per_sample = (t_max - t_small) / (app->block.max - small);
+
+		app->block.small = small;
+		app->block.t_small = t_small;
+		app->block.t_max = t_max;
+		app->block.overhead = t_small - per_sample * small;
+		app->block.valid = true;
+	}
+
+	_perf_deinit(&perf);
+	free(ns);
+
+	return 0;
+}
+
+static void
+_perf_connect(perf_t *perf, uint32_t p, float *wav)
+{
+	perf->wav[p] = wav;
+
+	lilv_instance_connect_port(perf->instance, p, wav);
+}
+
+static void
+_perf_reconnect(perf_t *perf)
+{
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		if(perf->wav[p] && (perf->wav[p] != perf->bufs[p].port->wav) )
+		{
+			_perf_connect(perf, p, perf->bufs[p].port->wav);
+		}
+	}
+}
+
+// run from a freshly activated state with a reproducible stimulus
+static uint64_t
+_perf_record(perf_t *perf, uint32_t nblocks, float *rec)
+{
+	uint64_t ns = 0;
+
+	perf->seed = PERF_SEED;
+	perf->phase = 0.0;
+
+	lilv_instance_deactivate(perf->instance);
+	lilv_instance_activate(perf->instance);
+
+	for(uint32_t b = 0; b < nblocks; b++)
+	{
+		_perf_fill(perf, STIM_noise);
+
+		ns += _perf_time(perf, perf->nsamples);
+
+		for(uint32_t p = 0; p < perf->nports; p++)
+		{
+			if(perf->kinds[p] == KIND_OUTPUT)
+			{
+				memcpy(rec, perf->wav[p], perf->nsamples * sizeof(float));
+				rec += perf->nsamples;
+			}
+		}
+	}
+
+	return ns;
+}
+
+static double
+_perf_diff(const float *a, const float *b, size_t n)
+{
+	double diff = 0.0;
+
+	for(size_t i = 0; i < n; i++)
+	{
+		if(isnan(a[i]) || isnan(b[i]))
+		{
+			if(isnan(a[i]) != isnan(b[i]))
+			{
+				return INFINITY;
+			}
+
+			continue;
+		}
+
+		const double d = fabs(a[i] - b[i]);
+
+		if(d > diff)
+		{
+			diff = d;
+		}
+	}
+
+	return diff;
+}
+
+static bool
+_is_audio(perf_t *perf, uint32_t p, kind_t kind)
+{
+	app_t *app = perf->app;
+	const LilvPort *port = lilv_plugin_get_port_by_index(app->plugin, p);
+
+	return (perf->kinds[p] == kind)
+		&& lilv_port_is_a(app->plugin, port, NODE(app, CORE__AudioPort));
+}
+
+// pair audio inputs with audio outputs in port order, like hosts do
+static uint32_t
+_inplace_pair(perf_t *perf, uint32_t *pair)
+{
+	uint32_t npairs = 0;
+
+	for(uint32_t p = 0; p < perf->nports; p++)
+	{
+		pair[p] = UINT32_MAX;
+	}
+
+	for(uint32_t i = 0, o = 0; (i < perf->nports) && (o < perf->nports); )
+	{
+		if(!_is_audio(perf, i, KIND_SIGNAL))
+		{
+			i++;
+		}
+		else if(!_is_audio(perf, o, KIND_OUTPUT))
+		{
+			o++;
+		}
+		else
+		{
+			pair[o++] = i++;
+			npairs++;
+		}
+	}
+
+	return npairs;
+}
+
+int
+lv2lint_perf_inplace(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	// only timed with the other DSP benchmarks
+	const uint32_t nblocks = app->dsp.enabled
+		? app->dsp.duration * app->sample_rate / app->dsp.nsamples
+		: INPLACE_BLOCKS;
+
+	if( (nblocks == 0) || !_perf_init(&perf, app, bufs) )
+	{
+		return 0;
+	}
+
+	const size_t nrec = (size_t)nblocks * perf.nout * app->dsp.nsamples;
+	float *ref = calloc(nrec, sizeof(float));
+	float *rec = calloc(nrec, sizeof(float));
+	uint32_t *pair = calloc(perf.nports, sizeof(uint32_t));
+
+	if(ref && rec && pair)
+	{
+		app->inplace.pairs = _inplace_pair(&perf, pair);
+	}
+
+	if(app->inplace.pairs)
+	{
+		// a second separate run tells apart non-determinism from breakage
+		_perf_record(&perf, nblocks, ref);
+		const uint64_t separate = _perf_record(&perf, nblocks, rec);
+
+		app->inplace.deterministic = _perf_diff(ref, rec, nrec) <= PERF_EPSILON;
+
+		for(uint32_t o = 0; o < perf.nports; o++)
+		{
+			if(pair[o] != UINT32_MAX)
+			{
+				_perf_connect(&perf, o, perf.wav[pair[o]]);
+			}
+		}
+
+		const uint64_t inplace = _perf_record(&perf, nblocks, rec);
+
+		_perf_reconnect(&perf);
+
+		app->inplace.diff = _perf_diff(ref, rec, nrec);
+		app->inplace.separate = (double)separate / nblocks / app->dsp.nsamples;
+		app->inplace.inplace = (double)inplace / nblocks / app->dsp.nsamples;
+		app->inplace.valid = true;
+	}
+
+	free(ref);
+	free(rec);
+	free(pair);
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+int
+lv2lint_perf_misalign(app_t *app, void *data)
+{
+	misalign_t *misalign = data;
+	const size_t offset = MISALIGN_OFFSET(misalign - app->misalign);
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	// only timed with the other DSP benchmarks
+	const uint32_t nblocks = app->dsp.enabled
+		? app->dsp.duration * app->sample_rate / app->dsp.nsamples
+		: MISALIGN_BLOCKS;
+
+	if( (nblocks == 0) || !_perf_init(&perf, app, app->bufs) )
+	{
+		return 0;
+	}
+
+	const size_t nrec = (size_t)nblocks * perf.nout * app->dsp.nsamples;
+	const size_t scratch_sz = app->dsp.nsamples * sizeof(float) + MISALIGN_ALIGN;
+	float *ref = calloc(nrec, sizeof(float));
+	float *rec = calloc(nrec, sizeof(float));
+	uint8_t **scratch = calloc(perf.nports, sizeof(uint8_t *));
+	bool ok = ref && rec && scratch;
+
+	for(uint32_t p = 0; ok && (p < perf.nports); p++)
+	{
+		if(!perf.wav[p])
+		{
+			continue;
+		}
+
+		scratch[p] = aligned_alloc(MISALIGN_ALIGN, scratch_sz);
+		ok = scratch[p] != NULL;
+	}
+
+	if(ok)
+	{
+		const uint64_t aligned = _perf_record(&perf, nblocks, ref);
+
+		for(uint32_t p = 0; p < perf.nports; p++)
+		{
+			if(scratch[p])
+			{
+				memset(scratch[p], 0x0, scratch_sz);
+				_perf_connect(&perf, p, (float *)(scratch[p] + offset));
+			}
+		}
+
+		const uint64_t misaligned = _perf_record(&perf, nblocks, rec);
+
+		_perf_reconnect(&perf);
+
+		misalign->diff = _perf_diff(ref, rec, nrec);
+
+		// only blame misalignment when a second aligned run is reproducible
+		if(misalign->diff > PERF_EPSILON)
+		{
+			_perf_record(&perf, nblocks, rec);
+
+			misalign->differs = _perf_diff(ref, rec, nrec) <= PERF_EPSILON;
+		}
+
+		misalign->aligned = (double)aligned / nblocks / app->dsp.nsamples;
+		misalign->misaligned = (double)misaligned / nblocks / app->dsp.nsamples;
+		misalign->valid = true;
+	}
+
+	for(uint32_t p = 0; scratch && (p < perf.nports); p++)
+	{
+		free(scratch[p]);
+	}
+
+	free(scratch);
+	free(ref);
+	free(rec);
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+static const struct {
+	uint32_t type;
+	uint64_t config;
+} counter_events [COUNTER_MAX] = {
+	[COUNTER_cycles] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	[COUNTER_instructions] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	[COUNTER_cache_references] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+	[COUNTER_cache_misses] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+	[COUNTER_branch_misses] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+	[COUNTER_context_switches] = {
+		PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES }
+};
+
+static int
+_counter_open(counter_t counter, int group_fd)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0x0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = counter_events[counter].type;
+	attr.config = counter_events[counter].config;
+	attr.disabled = group_fd == -1; // only the leader
+	// context switches happen in the kernel, thus need perf_event_paranoid<2
+	attr.exclude_kernel = attr.type != PERF_TYPE_SOFTWARE;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP
+		| PERF_FORMAT_TOTAL_TIME_ENABLED
+		| PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	// this thread, any CPU
+	return syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static int
+_counter_paranoid(void)
+{
+	int paranoid = -1;
+	FILE *f = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+
+	if(f)
+	{
+		if(fscanf(f, "%d", &paranoid) != 1)
+		{
+			paranoid = -1;
+		}
+
+		fclose(f);
+	}
+
+	return paranoid;
+}
+
+int
+lv2lint_perf_counters(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	int fds [COUNTER_MAX];
+	counter_t order [COUNTER_MAX];
+	unsigned nfds = 0;
+	int leader = -1;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	const uint32_t nblocks = app->dsp.duration * app->sample_rate
+		/ app->dsp.nsamples;
+
+	if( (nblocks == 0) || !_perf_init(&perf, app, bufs) )
+	{
+		return 0;
+	}
+
+	// unavailable members are skipped, the first available one leads
+	for(counter_t counter = 0; counter < COUNTER_MAX; counter++)
+	{
+		const int fd = _counter_open(counter, leader);
+
+		if(fd == -1)
+		{
+			if(leader == -1)
+			{
+				app->counters.error = errno;
+			}
+
+			continue;
+		}
+
+		if(leader == -1)
+		{
+			leader = fd;
+		}
+
+		fds[nfds] = fd;
+		order[nfds++] = counter;
+	}
+
+	if(leader == -1)
+	{
+		app->counters.paranoid = _counter_paranoid();
+		_perf_deinit(&perf);
+		return 0;
+	}
+
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+	for(uint32_t i = 0; i < nblocks; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	struct {
+		uint64_t nr;
+		uint64_t time_enabled;
+		uint64_t time_running;
+		uint64_t values [COUNTER_MAX];
+	} group;
+
+	if( (read(leader, &group, sizeof(group)) > 0)
+		&& (group.nr == nfds) && group.time_running)
+	{
+		// scale up when multiplexed with other groups
+		const double scale = (double)group.time_enabled / group.time_running;
+
+		for(unsigned i = 0; i < nfds; i++)
+		{
+			app->counters.avail[order[i]] = true;
+			app->counters.value[order[i]] = group.values[i] * scale;
+		}
+
+		app->counters.samples = (uint64_t)nblocks * app->dsp.nsamples;
+		app->counters.valid = true;
+	}
+
+	for(unsigned i = 0; i < nfds; i++)
+	{
+		close(fds[i]);
+	}
+
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+// the child has its own copy of signal dispositions, but shares memory
+static app_t *profile_app = NULL;
+
+static void
+_profile_sample(int sig __attribute__((unused)),
+	siginfo_t *si __attribute__((unused)), void *ctx __attribute__((unused)))
+{
+	app_t *app = profile_app;
+	const uint32_t n = app->profile.nsamples;
+
+	if(n < PROFILE_MAX)
+	{
+		app->profile.depth[n] = backtrace(app->profile.frames[n], PROFILE_DEPTH);
+		app->profile.nsamples = n + 1;
+	}
+}
+
+int
+lv2lint_perf_profile(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	struct sigaction sa;
+	struct itimerval it;
+	void *prime [1];
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	if(!_perf_init(&perf, app, bufs))
+	{
+		return 0;
+	}
+
+	// loads the unwinder, which must not happen in the signal handler
+	backtrace(prime, 1);
+
+	memset(&sa, 0x0, sizeof(sa));
+	sa.sa_sigaction = _profile_sample;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+
+	profile_app = app;
+	sigaction(SIGPROF, &sa, NULL);
+
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	memset(&it, 0x0, sizeof(it));
+	it.it_interval.tv_usec = PROFILE_INTERVAL;
+	it.it_value.tv_usec = PROFILE_INTERVAL;
+	setitimer(ITIMER_PROF, &it, NULL);
+
+	const uint64_t t0 = _now();
+
+	while( (app->profile.nsamples < PROFILE_MAX)
+		&& (_now() - t0 < PROFILE_DURATION * 1000000000ULL) )
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	memset(&it, 0x0, sizeof(it));
+	setitimer(ITIMER_PROF, &it, NULL);
+	signal(SIGPROF, SIG_IGN); // a pending signal would terminate otherwise
+
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+typedef struct _lane_t lane_t;
+typedef struct _sync_t sync_t;
+
+struct _sync_t {
+	atomic_uint ready;
+	atomic_uint done;
+	atomic_bool go;
+	atomic_bool stop;
+};
+
+struct _lane_t {
+	perf_t perf;
+	buf_t *bufs;
+	int cpu;
+	pthread_t thread;
+	sync_t *sync;
+	uint32_t nblocks;
+	uint64_t ns;
+	float *rec; // outputs of the final blocks
+};
+
+static inline void
+_spin(atomic_bool *flag)
+{
+	// no syscalls while others are counted
+	while(!atomic_load_explicit(flag, memory_order_acquire))
+	{
+		// busy wait
+	}
+}
+
+static inline void
+_spin_until(atomic_uint *count, unsigned n)
+{
+	while(atomic_load_explicit(count, memory_order_acquire) < n)
+	{
+		// busy wait
+	}
+}
+
+static void
+_lane_pin(lane_t *lane)
+{
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	CPU_SET(lane->cpu, &set);
+
+	// of the calling thread only
+	sched_setaffinity(0, sizeof(set), &set);
+}
+
+static void
+_lane_reset(lane_t *lane)
+{
+	lane->perf.seed = PERF_SEED;
+	lane->perf.phase = 0.0;
+
+	lilv_instance_deactivate(lane->perf.instance);
+	lilv_instance_activate(lane->perf.instance);
+}
+
+static void
+_lane_warmup(lane_t *lane)
+{
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&lane->perf, STIM_noise);
+	}
+}
+
+static void
+_lane_measure(lane_t *lane)
+{
+	perf_t *perf = &lane->perf;
+	float *rec = lane->rec;
+
+	const uint64_t t0 = _now();
+
+	for(uint32_t b = 0; b < lane->nblocks; b++)
+	{
+		_perf_run(perf, STIM_noise);
+
+		if(b < lane->nblocks - SCALING_RECORD)
+		{
+			continue;
+		}
+
+		for(uint32_t p = 0; p < perf->nports; p++)
+		{
+			if(perf->kinds[p] == KIND_OUTPUT)
+			{
+				memcpy(rec, perf->wav[p], perf->nsamples * sizeof(float));
+				rec += perf->nsamples;
+			}
+		}
+	}
+
+	lane->ns = _now() - t0;
+}
+
+static void *
+_lane_thread(void *data)
+{
+	lane_t *lane = data;
+	sync_t *sync = lane->sync;
+
+	_lane_pin(lane);
+	_lane_warmup(lane);
+
+	atomic_fetch_add_explicit(&sync->ready, 1, memory_order_acq_rel);
+	_spin(&sync->go);
+
+	_lane_measure(lane);
+
+	atomic_fetch_add_explicit(&sync->done, 1, memory_order_acq_rel);
+	_spin(&sync->stop); // thread exit would be counted otherwise
+
+	return NULL;
+}
+
+static bool
+_lane_init(lane_t *lane, app_t *app, const LV2_Feature **features,
+	uint32_t nrec)
+{
+	lane->rec = calloc(nrec, sizeof(float));
+	lane->bufs = calloc(app->nbufs, sizeof(buf_t));
+
+	if(!lane->rec || !lane->bufs)
+	{
+		return false;
+	}
+
+	// private port buffers with the same headers and control values
+	for(uint32_t p = 0; p < app->nbufs; p++)
+	{
+		const buf_t *src = &app->bufs[p];
+		buf_t *dst = &lane->bufs[p];
+		size_t size = src->size > sizeof(port_t) ? src->size : sizeof(port_t);
+
+		size = (size + SCALING_ALIGN - 1) & ~(SCALING_ALIGN - 1); // no false sharing
+		dst->port = aligned_alloc(SCALING_ALIGN, size);
+		if(!dst->port)
+		{
+			return false;
+		}
+
+		memset(dst->port, 0x0, size);
+		memcpy(dst->port, src->port, src->size);
+		dst->size = src->size;
+	}
+
+	LilvInstance *instance = lilv_plugin_instantiate(app->plugin,
+		app->sample_rate, features);
+	if(!instance)
+	{
+		return false;
+	}
+
+	if(!_perf_init(&lane->perf, app, lane->bufs))
+	{
+		lane->perf.instance = NULL; // not ours to free
+		lilv_instance_free(instance);
+		return false;
+	}
+
+	lane->perf.instance = instance;
+
+	for(uint32_t p = 0; p < app->nbufs; p++)
+	{
+		lilv_instance_connect_port(instance, p, lane->bufs[p].port);
+	}
+
+	lilv_instance_activate(instance);
+
+	return true;
+}
+
+static void
+_lane_deinit(lane_t *lane, app_t *app)
+{
+	if(lane->perf.instance)
+	{
+		lilv_instance_deactivate(lane->perf.instance);
+		lilv_instance_free(lane->perf.instance);
+		_perf_deinit(&lane->perf);
+	}
+
+	if(lane->bufs)
+	{
+		for(uint32_t p = 0; p < app->nbufs; p++)
+		{
+			free(lane->bufs[p].port);
+		}
+
+		free(lane->bufs);
+	}
+
+	free(lane->rec);
+}
+
+static unsigned
+_scaling_cpus(int *cpus, unsigned max)
+{
+	cpu_set_t set;
+	unsigned n = 0;
+
+	if(sched_getaffinity(0, sizeof(set), &set) == -1)
+	{
+		return 0;
+	}
+
+	for(int cpu = 0; (cpu < CPU_SETSIZE) && (n < max); cpu++)
+	{
+		if(CPU_ISSET(cpu, &set))
+		{
+			cpus[n++] = cpu;
+		}
+	}
+
+	return n;
+}
+
+int
+lv2lint_perf_scaling(app_t *app, void *data)
+{
+	const LV2_Feature **features = data;
+	int cpus [SCALING_MAX];
+	sync_t sync;
+	lane_t *lanes;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	const uint32_t nblocks = app->dsp.duration * app->sample_rate
+		/ app->dsp.nsamples;
+	const unsigned max = app->scaling.instances < SCALING_MAX
+		? app->scaling.instances
+		: SCALING_MAX;
+	const unsigned n = _scaling_cpus(cpus, max);
+
+	if( (nblocks < SCALING_RECORD) || (n < 2) )
+	{
+		return 0;
+	}
+
+	lanes = calloc(n, sizeof(lane_t));
+	if(!lanes)
+	{
+		return 0;
+	}
+
+	atomic_init(&sync.ready, 0);
+	atomic_init(&sync.done, 0);
+	atomic_init(&sync.go, false);
+	atomic_init(&sync.stop, false);
+
+	const bool init = _perf_init(&lanes[0].perf, app, app->bufs);
+	bool ok = init;
+	uint32_t nrec = 0;
+
+	if(ok)
+	{
+		nrec = lanes[0].perf.nout * SCALING_RECORD * app->dsp.nsamples;
+		lanes[0].rec = calloc(nrec ? nrec : 1, sizeof(float));
+		ok = lanes[0].rec != NULL;
+	}
+
+	// instantiation and activation must not run concurrently
+	for(unsigned i = 1; ok && (i < n); i++)
+	{
+		ok = _lane_init(&lanes[i], app, features, nrec ? nrec : 1);
+	}
+
+	if(ok)
+	{
+		float *single = calloc(nrec ? nrec : 1, sizeof(float));
+
+		for(unsigned i = 0; i < n; i++)
+		{
+			lanes[i].cpu = cpus[i];
+			lanes[i].sync = &sync;
+			lanes[i].nblocks = nblocks;
+		}
+
+		// reference with the same lane on its own
+		_lane_pin(&lanes[0]);
+		_lane_reset(&lanes[0]);
+		_lane_warmup(&lanes[0]);
+		_lane_measure(&lanes[0]);
+
+		const uint64_t ns_single = lanes[0].ns;
+
+		if(single)
+		{
+			memcpy(single, lanes[0].rec, nrec * sizeof(float));
+		}
+
+		// a second instance on its own tells whether the output is reproducible
+		_lane_pin(&lanes[1]);
+		_lane_reset(&lanes[1]);
+		_lane_warmup(&lanes[1]);
+		_lane_measure(&lanes[1]);
+		_lane_pin(&lanes[0]);
+
+		const bool deterministic = single
+			&& (_perf_diff(single, lanes[1].rec, nrec) <= PERF_EPSILON);
+
+		for(unsigned i = 0; i < n; i++)
+		{
+			_lane_reset(&lanes[i]);
+		}
+
+		unsigned nthreads = 1;
+
+		for( ; nthreads < n; nthreads++)
+		{
+			if(pthread_create(&lanes[nthreads].thread, NULL, _lane_thread,
+				&lanes[nthreads]))
+			{
+				break;
+			}
+		}
+
+		_lane_warmup(&lanes[0]);
+		_spin_until(&sync.ready, nthreads - 1);
+
+		shm_enable(app->shm);
+		atomic_store_explicit(&sync.go, true, memory_order_release);
+
+		_lane_measure(&lanes[0]);
+
+		_spin_until(&sync.done, nthreads - 1);
+		shm_disable(app->shm);
+		atomic_store_explicit(&sync.stop, true, memory_order_release);
+
+		for(unsigned i = 1; i < nthreads; i++)
+		{
+			pthread_join(lanes[i].thread, NULL);
+		}
+
+		if( (nthreads == n) && single)
+		{
+			double ratio = 0.0;
+			double ns = 0.0;
+
+			app->scaling.deterministic = deterministic;
+
+			for(unsigned i = 0; i < n; i++)
+			{
+				ratio += (double)ns_single / lanes[i].ns;
+				ns += lanes[i].ns;
+
+				const double diff = _perf_diff(single, lanes[i].rec, nrec);
+
+				if(diff > PERF_EPSILON)
+				{
+					app->scaling.diverged++;
+				}
+
+				if(diff > app->scaling.diff)
+				{
+					app->scaling.diff = diff;
+				}
+			}
+
+			app->scaling.n = n;
+			app->scaling.single = (double)ns_single / nblocks;
+			app->scaling.concurrent = ns / n / nblocks;
+			app->scaling.efficiency = ratio / n;
+			app->scaling.calls = (uint64_t)n * nblocks;
+			app->scaling.valid = true;
+		}
+
+		free(single);
+	}
+
+	for(unsigned i = 1; i < n; i++)
+	{
+		_lane_deinit(&lanes[i], app);
+	}
+
+	if(init)
+	{
+		_perf_deinit(&lanes[0].perf);
+	}
+
+	free(lanes[0].rec);
+	free(lanes);
+
+	return 0;
+}
+
+bool
+lv2lint_rollup(rollup_t *rollup)
+{
+	FILE *f = fopen("/proc/self/smaps_rollup", "r");
+	char line [256];
+	unsigned found = 0;
+
+	if(!f)
+	{
+		return false;
+	}
+
+	memset(rollup, 0x0, sizeof(rollup_t));
+
+	while(fgets(line, sizeof(line), f))
+	{
+		uint64_t kb;
+
+		if(sscanf(line, "Rss: %"SCNu64" kB", &kb) == 1)
+		{
+			rollup->rss = kb << 10;
+			found++;
+		}
+		else if(sscanf(line, "Pss: %"SCNu64" kB", &kb) == 1)
+		{
+			rollup->pss = kb << 10;
+			found++;
+		}
+		else if(sscanf(line, "Anonymous: %"SCNu64" kB", &kb) == 1)
+		{
+			rollup->anon = kb << 10;
+			found++;
+		}
+	}
+
+	fclose(f);
+
+	return found == 3;
+}
+
+static wss_t
+_wss_classify(app_t *app, uintptr_t start, const char *path, const char *dso,
+	uintptr_t dso_end)
+{
+	if(dso[0] && !strcmp(path, dso))
+	{
+		return WSS_dso;
+	}
+
+	if( (path[0] != '\0') && strncmp(path, "[heap]", 6) )
+	{
+		return WSS_other;
+	}
+
+	if(start == dso_end) // .bss beyond the file backed part
+	{
+		return WSS_dso;
+	}
+
+	if(start == app->stack.bottom)
+	{
+		return WSS_other;
+	}
+
+	for(uint32_t p = 0; p < app->nbufs; p++)
+	{
+		const buf_t *buf = &app->bufs[p];
+
+		if( (start >= (uintptr_t)buf->map)
+			&& (start < (uintptr_t)buf->map + buf->map_size) )
+		{
+			return WSS_ports;
+		}
+	}
+
+	return WSS_heap;
+}
+
+// sums the given smaps field in KiB per class of mapping
+static bool
+_wss_read(app_t *app, uintptr_t fbase, const char *field, uint64_t *kib)
+{
+	const size_t field_len = strlen(field);
+	FILE *f = fopen("/proc/self/smaps", "r");
+	char line [512];
+	char dso [512] = "";
+	uintptr_t dso_end = 0;
+	wss_t wss = WSS_other;
+
+	if(!f)
+	{
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f))
+	{
+		uintptr_t start;
+		uintptr_t end;
+		char perms [5];
+		unsigned long inode;
+		int len = 0;
+		uint64_t kb;
+
+		if(sscanf(line, "%"SCNxPTR"-%"SCNxPTR" %4s %*s %*s %lu %n", &start, &end,
+			perms, &inode, &len) >= 4)
+		{
+			const char *path = &line[len]; // empty for anonymous mappings
+
+			if(start == fbase) // the ELF header comes first
+			{
+				snprintf(dso, sizeof(dso), "%s", path);
+			}
+
+			wss = _wss_classify(app, start, path, dso, dso_end);
+
+			if(wss == WSS_dso)
+			{
+				dso_end = end;
+			}
+		}
+		else if(!strncmp(line, field, field_len)
+			&& (sscanf(&line[field_len], " %"SCNu64" kB", &kb) == 1) )
+		{
+			kib[wss] += kb;
+		}
+	}
+
+	fclose(f);
+
+	return true;
+}
+
+typedef struct _region_t region_t;
+typedef struct _hashed_t hashed_t;
+
+struct _region_t {
+	uintptr_t start;
+	uintptr_t end;
+};
+
+struct _hashed_t {
+	uint64_t hash;
+	const uint8_t *page;
+};
+
+static int
+_hashed_cmp(const void *a, const void *b)
+{
+	const hashed_t *A = a;
+	const hashed_t *B = b;
+
+	return (A->hash > B->hash) - (A->hash < B->hash);
+}
+
+static uint64_t
+_page_hash(const uint64_t *page, size_t nwords)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a
+	uint64_t any = 0;
+
+	for(size_t i = 0; i < nwords; i++)
+	{
+		hash = (hash ^ page[i]) * 0x100000001b3ULL;
+		any |= page[i];
+	}
+
+	return any ? hash : 0; // zero pages are shared by the kernel anyway
+}
+
+// private anonymous mappings, the heap included, in ascending order
+static region_t *
+_regions(unsigned *nregions)
+{
+	region_t *regions = NULL;
+	char line [512];
+
+	*nregions = 0;
+
+	FILE *f = fopen("/proc/self/maps", "r");
+	if(!f)
+	{
+		return NULL;
+	}
+
+	while(fgets(line, sizeof(line), f))
+	{
+		uintptr_t start;
+		uintptr_t end;
+		char perms [5];
+		unsigned long inode;
+		int len = 0;
+
+		if(sscanf(line, "%"SCNxPTR"-%"SCNxPTR" %4s %*s %*s %lu %n", &start, &end,
+			perms, &inode, &len) < 4)
+		{
+			continue;
+		}
+
+		const char *path = &line[len]; // empty for anonymous mappings
+
+		if( (perms[0] != 'r') || (perms[1] != 'w') || (perms[3] != 'p') || inode
+			|| ( (path[0] != '\0') && strncmp(path, "[heap]", 6) ) )
+		{
+			continue;
+		}
+
+		region_t *tmp = realloc(regions, (*nregions + 1) * sizeof(region_t));
+		if(!tmp)
+		{
+			break;
+		}
+
+		regions = tmp;
+		regions[*nregions].start = start;
+		regions[(*nregions)++].end = end;
+	}
+
+	fclose(f);
+
+	return regions;
+}
+
+// parts of `regions` not covered by `base`, e.g. new mappings and heap growth
+static region_t *
+_regions_new(const region_t *regions, unsigned nregions, const region_t *base,
+	unsigned nbase, unsigned *nnew)
+{
+	region_t *fresh = calloc(nregions + nbase + 1, sizeof(region_t));
+
+	*nnew = 0;
+
+	if(!fresh)
+	{
+		return NULL;
+	}
+
+	for(unsigned r = 0; r < nregions; r++)
+	{
+		uintptr_t cursor = regions[r].start;
+
+		for(unsigned b = 0; (b < nbase) && (cursor < regions[r].end); b++)
+		{
+			if( (base[b].end <= cursor) || (base[b].start >= regions[r].end) )
+			{
+				continue;
+			}
+
+			if(base[b].start > cursor)
+			{
+				fresh[*nnew].start = cursor;
+				fresh[(*nnew)++].end = base[b].start;
+			}
+
+			cursor = base[b].end;
+		}
+
+		if(cursor < regions[r].end)
+		{
+			fresh[*nnew].start = cursor;
+			fresh[(*nnew)++].end = regions[r].end;
+		}
+	}
+
+	return fresh;
+}
+
+// bytes of resident pages mapped since `base` with content identical to
+// another such page, hashed first and compared in full on equal hashes
+static bool
+_duplicated(const region_t *base, unsigned nbase, uint64_t *bytes)
+{
+	const size_t page_size = sysconf(_SC_PAGESIZE);
+	unsigned nregions = 0;
+	unsigned nfresh = 0;
+	size_t npages = 0;
+
+	region_t *regions = _regions(&nregions);
+	region_t *fresh = _regions_new(regions, nregions, base, nbase, &nfresh);
+
+	for(unsigned r = 0; r < nfresh; r++)
+	{
+		npages += (fresh[r].end - fresh[r].start) / page_size;
+	}
+
+	hashed_t *hashed = calloc(npages ? npages : 1, sizeof(hashed_t));
+	unsigned char *vec = calloc(npages ? npages : 1, 1);
+	size_t nhashed = 0;
+
+	if(!regions || !fresh || !hashed || !vec)
+	{
+		free(hashed);
+		free(vec);
+		free(fresh);
+		free(regions);
+		return false;
+	}
+
+	for(unsigned r = 0; r < nfresh; r++)
+	{
+		const uint8_t *start = (const uint8_t *)fresh[r].start;
+		const size_t n = (fresh[r].end - fresh[r].start) / page_size;
+
+		// only resident pages, reading the others would fault them in
+		if(mincore((void *)start, n * page_size, vec) == -1)
+		{
+			continue;
+		}
+
+		for(size_t i = 0; i < n; i++)
+		{
+			if(!(vec[i] & 1))
+			{
+				continue;
+			}
+
+			const uint8_t *page = &start[i * page_size];
+			const uint64_t hash = _page_hash((const uint64_t *)page,
+				page_size / sizeof(uint64_t));
+
+			if(hash)
+			{
+				hashed[nhashed].hash = hash;
+				hashed[nhashed++].page = page;
+			}
+		}
+	}
+
+	qsort(hashed, nhashed, sizeof(hashed_t), _hashed_cmp);
+
+	*bytes = 0;
+
+	for(size_t i = 1; i < nhashed; i++)
+	{
+		// pages with equal hashes are adjacent, look for an identical one
+		for(size_t j = i; (j > 0) && (hashed[j - 1].hash == hashed[i].hash); j--)
+		{
+			if(!memcmp(hashed[j - 1].page, hashed[i].page, page_size))
+			{
+				*bytes += page_size;
+				break;
+			}
+		}
+	}
+
+	free(hashed);
+	free(vec);
+	free(fresh);
+	free(regions);
+
+	return true;
+}
+
+int
+lv2lint_perf_density(app_t *app, void *data)
+{
+	const LV2_Feature **features = data;
+	LilvInstance *instances [DENSITY_MAX];
+	uint64_t kib [WSS_MAX];
+	rollup_t base;
+	rollup_t rollup;
+	region_t *regions;
+	unsigned nregions = 0;
+	uint64_t dup;
+	Dl_info plugin;
+	double sx = 0.0;
+	double sxx = 0.0;
+	double srss = 0.0;
+	double spss = 0.0;
+	double sxrss = 0.0;
+	double sxpss = 0.0;
+	unsigned npoints = 0;
+	unsigned n = 0;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	// the one-off cost of the DSO, already loaded with the main instance
+	memset(kib, 0x0, sizeof(kib));
+
+	if(!dladdr(lilv_instance_get_descriptor(app->instance), &plugin)
+		|| !_wss_read(app, (uintptr_t)plugin.dli_fbase, "Rss:", kib)
+		|| !(regions = _regions(&nregions))
+		|| !lv2lint_rollup(&base) )
+	{
+		return 0;
+	}
+
+	// 1, 2, 4 ... additional instances, fitted by least squares
+	for(unsigned k = 1; k <= DENSITY_MAX; k <<= 1)
+	{
+		for( ; n < k; n++)
+		{
+			instances[n] = lilv_plugin_instantiate(app->plugin, app->sample_rate,
+				features);
+			if(!instances[n])
+			{
+				break;
+			}
+
+			// not run, thus sharing the port buffers is fine
+			for(uint32_t p = 0; p < app->nbufs; p++)
+			{
+				lilv_instance_connect_port(instances[n], p, app->bufs[p].port);
+			}
+
+			lilv_instance_activate(instances[n]);
+		}
+
+		if( (n < k) || !lv2lint_rollup(&rollup) )
+		{
+			break;
+		}
+
+		const double rss = (double)rollup.rss - base.rss;
+		const double pss = (double)rollup.pss - base.pss;
+
+		sx += k;
+		sxx += (double)k * k;
+		srss += rss;
+		spss += pss;
+		sxrss += k * rss;
+		sxpss += k * pss;
+		npoints++;
+
+		if(rss > DENSITY_BUDGET)
+		{
+			break;
+		}
+	}
+
+	// n copies of per-instance data in the new pages are n - 1 duplicates
+	if( (npoints > 1) && _duplicated(regions, nregions, &dup) )
+	{
+		const double det = npoints * sxx - sx * sx;
+
+		app->density.n = n;
+		app->density.rss = (npoints * sxrss - sx * srss) / det;
+		app->density.pss = (npoints * sxpss - sx * spss) / det;
+		app->density.dso = kib[WSS_dso] << 10;
+		app->density.duplicated = (double)dup / (n - 1);
+		app->density.valid = true;
+	}
+
+	free(regions);
+
+	for(unsigned i = 0; i < n; i++)
+	{
+		lilv_instance_deactivate(instances[i]);
+		lilv_instance_free(instances[i]);
+	}
+
+	return 0;
+}
+
+static uint64_t
+_lazy_run(perf_t *perf, unsigned *allocs, uint64_t *syscalls)
+{
+	app_t *app = perf->app;
+	const unsigned count = app->shm->heap[PHASE_run].count;
+	const uint64_t calls = app->trace.syscalls;
+
+	_perf_fill(perf, STIM_noise);
+
+	// interposer and tracer account while enabled
+	shm_enter(app->shm, PHASE_run);
+	shm_enable(app->shm);
+
+	const uint64_t ns = _perf_time(perf, perf->nsamples);
+
+	shm_disable(app->shm);
+	shm_leave(app->shm);
+
+	*allocs += app->shm->heap[PHASE_run].count - count;
+	*syscalls += app->trace.syscalls - calls;
+
+	return ns;
+}
+
+int
+lv2lint_perf_lazy(app_t *app, void *data)
+{
+	const LV2_Feature **features = data;
+	uint64_t ns [LAZY_STEADY];
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	if(!_perf_init(&perf, app, app->bufs))
+	{
+		return 0;
+	}
+
+	// a fresh instance has not been run by any other test yet, unless the
+	// worker belongs to the main instance, which is reactivated instead
+	if(app->work_iface)
+	{
+		lilv_instance_deactivate(perf.instance);
+	}
+	else
+	{
+		perf.instance = lilv_plugin_instantiate(app->plugin, app->sample_rate,
+			features);
+
+		if(!perf.instance)
+		{
+			_perf_deinit(&perf);
+			return 0;
+		}
+
+		for(uint32_t p = 0; p < app->nbufs; p++)
+		{
+			lilv_instance_connect_port(perf.instance, p, app->bufs[p].port);
+		}
+	}
+
+	// only the first run() belongs to the memory pool report
+	const usage_t heap = app->shm->heap[PHASE_run];
+
+	lilv_instance_activate(perf.instance);
+
+	for(uint32_t i = 0; i < LAZY_FIRST; i++)
+	{
+		app->lazy.first[i] = _lazy_run(&perf, &app->lazy.first_allocs,
+			&app->lazy.first_syscalls);
+	}
+
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	for(uint32_t i = 0; i < LAZY_STEADY; i++)
+	{
+		ns[i] = _lazy_run(&perf, &app->lazy.steady_allocs,
+			&app->lazy.steady_syscalls);
+	}
+
+	qsort(ns, LAZY_STEADY, sizeof(uint64_t), _cmp);
+	app->lazy.steady = _percentile(ns, LAZY_STEADY, 0.50);
+
+	// a host toggling activation must not hit the same spike again
+	lilv_instance_deactivate(perf.instance);
+	lilv_instance_activate(perf.instance);
+
+	for(uint32_t i = 0; i < LAZY_FIRST; i++)
+	{
+		app->lazy.react[i] = _lazy_run(&perf, &app->lazy.react_allocs,
+			&app->lazy.react_syscalls);
+	}
+
+	if(perf.instance != app->instance)
+	{
+		lilv_instance_deactivate(perf.instance);
+		lilv_instance_free(perf.instance);
+	}
+
+	app->shm->heap[PHASE_run] = heap;
+	app->lazy.valid = true;
+
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+static unsigned
+_fds(void)
+{
+	DIR *dir = opendir("/proc/self/fd");
+	unsigned n = 0;
+
+	if(!dir)
+	{
+		return 0;
+	}
+
+	for(struct dirent *ent = readdir(dir); ent; ent = readdir(dir))
+	{
+		if(ent->d_name[0] != '.')
+		{
+			n++;
+		}
+	}
+
+	closedir(dir);
+
+	return n ? n - 1 : 0; // minus the directory itself
+}
+
+static unsigned
+_threads(void)
+{
+	FILE *f = fopen("/proc/self/status", "r");
+	char line [256];
+	unsigned n = 0;
+
+	if(!f)
+	{
+		return 0;
+	}
+
+	while(fgets(line, sizeof(line), f))
+	{
+		if(sscanf(line, "Threads: %u", &n) == 1)
+		{
+			break;
+		}
+	}
+
+	fclose(f);
+
+	return n;
+}
+
+static void
+_resources(app_t *app, int64_t *res)
+{
+	rollup_t rollup;
+
+	// live bytes tracked since settling, unlike arena statistics not hidden by
+	// free lists and caches of the allocator
+	res[RESOURCE_heap] = 0;
+	for(phase_t phase = 0; phase < PHASE_MAX; phase++)
+	{
+		res[RESOURCE_heap] += app->shm->outstanding[phase].bytes;
+	}
+	app->cycle.avail[RESOURCE_heap] = true;
+
+	if(lv2lint_rollup(&rollup))
+	{
+		res[RESOURCE_rss] = rollup.rss;
+		app->cycle.avail[RESOURCE_rss] = true;
+	}
+
+	res[RESOURCE_fds] = _fds();
+	app->cycle.avail[RESOURCE_fds] = res[RESOURCE_fds] > 0;
+
+	res[RESOURCE_threads] = _threads();
+	app->cycle.avail[RESOURCE_threads] = res[RESOURCE_threads] > 0;
+}
+
+/*
+ * Growth is taken between the means of the first and last third of the
+ * samples and only counts if every sample of the last third lies above every
+ * sample of the first, so a single sample dropping in between, e.g. due to a
+ * cache trimmed once, does not hide a steady leak and a single step does not
+ * make one.
+ */
+static void
+_cycle_growth(app_t *app, int64_t samples [CYCLE_SAMPLES][RESOURCE_MAX])
+{
+	const unsigned third = CYCLE_SAMPLES / 3;
+
+	for(resource_t r = 0; r < RESOURCE_MAX; r++)
+	{
+		int64_t max = INT64_MIN;
+		int64_t min = INT64_MAX;
+		double head = 0.0;
+		double tail = 0.0;
+
+		for(unsigned i = 0; i < third; i++)
+		{
+			const int64_t h = samples[i][r];
+			const int64_t t = samples[CYCLE_SAMPLES - third + i][r];
+
+			max = h > max ? h : max;
+			min = t < min ? t : min;
+			head += h;
+			tail += t;
+		}
+
+		// cycles between the centers of both thirds
+		const double cycles = (CYCLE_SAMPLES - third) * CYCLE_SAMPLE;
+
+		app->cycle.grows[r] = min > max;
+		app->cycle.growth[r] = (tail - head) / third / cycles;
+	}
+}
+
+int
+lv2lint_perf_cycle(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	uint64_t ns [CYCLE_COUNT];
+	int64_t samples [CYCLE_SAMPLES][RESOURCE_MAX];
+	usage_t heap [PHASE_MAX];
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	if(!_perf_init(&perf, app, bufs))
+	{
+		return 0;
+	}
+
+	memset(samples, 0x0, sizeof(samples));
+
+	// the heap report belongs to the first activation
+	memcpy(heap, app->shm->heap, sizeof(heap));
+
+	for(uint32_t i = 0; i < CYCLE_SETTLE + CYCLE_COUNT; i++)
+	{
+		if(i == CYCLE_SETTLE)
+		{
+			// unwinds every allocation of the timed cycles, as would a leak test
+			shm_track(app->shm);
+		}
+
+		const uint64_t t0 = _now();
+
+		shm_enter(app->shm, PHASE_deactivate);
+		lilv_instance_deactivate(app->instance);
+		shm_leave(app->shm);
+
+		shm_enter(app->shm, PHASE_activate);
+		lilv_instance_activate(app->instance);
+		shm_leave(app->shm);
+
+		shm_enter(app->shm, PHASE_run);
+		_perf_run(&perf, STIM_noise);
+		shm_leave(app->shm);
+
+		if(i < CYCLE_SETTLE)
+		{
+			continue;
+		}
+
+		const uint32_t c = i - CYCLE_SETTLE;
+
+		ns[c] = _now() - t0;
+
+		if(c % CYCLE_SAMPLE)
+		{
+			continue;
+		}
+
+		// sampled outside the timed section
+		_resources(app, samples[c / CYCLE_SAMPLE]);
+	}
+
+	shm_untrack(app->shm);
+
+	memcpy(app->shm->heap, heap, sizeof(heap));
+
+	_cycle_growth(app, samples);
+
+	qsort(ns, CYCLE_COUNT, sizeof(uint64_t), _cmp);
+
+	app->cycle.ns = _percentile(ns, CYCLE_COUNT, 0.50);
+	app->cycle.valid = true;
+
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+// innermost return address inside the plugin DSO
+static void *
+_leak_site(const live_t *live, const void *fbase)
+{
+	for(unsigned f = 0; f < live->depth; f++)
+	{
+		Dl_info info;
+
+		if(dladdr(live->frames[f], &info) && (info.dli_fbase == fbase) )
+		{
+			return live->frames[f];
+		}
+	}
+
+	return NULL;
+}
+
+static void
+_leak_name(char *name, void *addr)
+{
+	// return addresses point past the call
+	const uintptr_t call = (uintptr_t)addr - 1;
+	Dl_info info;
+
+	if(!dladdr((void *)call, &info))
+	{
+		snprintf(name, LEAK_NAME_MAX, "[unknown]");
+	}
+	else if(info.dli_sname)
+	{
+		snprintf(name, LEAK_NAME_MAX, "%s+0x%"PRIxPTR, info.dli_sname,
+			call - (uintptr_t)info.dli_saddr);
+	}
+	else
+	{
+		const char *base = strrchr(info.dli_fname, '/');
+
+		snprintf(name, LEAK_NAME_MAX, "[%s+0x%"PRIxPTR"]",
+			base ? base + 1 : info.dli_fname, call - (uintptr_t)info.dli_fbase);
+	}
+}
+
+/*
+ * The main instance is freed only after its test results have been printed,
+ * and tracking it over its whole life would unwind the stack on every
+ * allocation of all other benchmarks and overflow the slot table. Thus a
+ * second instance is taken through the whole life cycle here instead.
+ */
+int
+lv2lint_perf_leak(app_t *app, void *data)
+{
+	const LV2_Feature **features = data;
+	void *sites [LEAK_SITES];
+	usage_t usage [LEAK_SITES];
+	usage_t heap [PHASE_MAX];
+	unsigned nsites = 0;
+	Dl_info plugin;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	if(!dladdr(lilv_instance_get_descriptor(app->instance), &plugin)
+		|| !_perf_init(&perf, app, app->bufs) )
+	{
+		return 0;
+	}
+
+	// the heap report belongs to the main instance
+	memcpy(heap, app->shm->heap, sizeof(heap));
+
+	shm_track(app->shm);
+
+	shm_enter(app->shm, PHASE_instantiate);
+	perf.instance = lilv_plugin_instantiate(app->plugin, app->sample_rate,
+		features);
+	shm_leave(app->shm);
+
+	if(perf.instance)
+	{
+		shm_enter(app->shm, PHASE_connect_port);
+		for(uint32_t p = 0; p < app->nbufs; p++)
+		{
+			lilv_instance_connect_port(perf.instance, p, app->bufs[p].port);
+		}
+		shm_leave(app->shm);
+
+		shm_enter(app->shm, PHASE_activate);
+		lilv_instance_activate(perf.instance);
+		shm_leave(app->shm);
+
+		// the worker ring buffers belong to the main instance
+		app->leak.norun = app->work_iface != NULL;
+
+		if(!app->leak.norun)
+		{
+			for(uint32_t i = 0; i < PERF_WARMUP; i++)
+			{
+				_perf_fill(&perf, STIM_noise);
+
+				shm_enter(app->shm, PHASE_run);
+				_perf_time(&perf, app->dsp.nsamples);
+				shm_leave(app->shm);
+			}
+		}
+
+		shm_enter(app->shm, PHASE_deactivate);
+		lilv_instance_deactivate(perf.instance);
+		shm_leave(app->shm);
+
+		shm_enter(app->shm, PHASE_cleanup);
+		lilv_instance_free(perf.instance);
+		shm_leave(app->shm);
+	}
+
+	shm_untrack(app->shm);
+
+	memcpy(app->shm->heap, heap, sizeof(heap));
+
+	if(!perf.instance)
+	{
+		_perf_deinit(&perf);
+		return 0;
+	}
+
+	for(unsigned i = 0; i < LIVE_SLOTS; i++)
+	{
+		const live_t *live = &app->shm->live[i];
+
+		if(!live->ptr || (live->ptr == LIVE_FREED) )
+		{
+			continue;
+		}
+
+		void *site = _leak_site(live, plugin.dli_fbase);
+
+		if(!site) // allocated on behalf of the host or libraries
+		{
+			continue;
+		}
+
+		app->leak.live[live->phase].count++;
+		app->leak.live[live->phase].bytes += live->size;
+
+		unsigned s;
+
+		for(s = 0; (s < nsites) && (sites[s] != site); s++)
+		{
+			// search
+		}
+
+		if(s == nsites)
+		{
+			if(nsites == LEAK_SITES)
+			{
+				continue;
+			}
+
+			sites[s] = site;
+			usage[s].count = 0;
+			usage[s].bytes = 0;
+			nsites++;
+		}
+
+		usage[s].count++;
+		usage[s].bytes += live->size;
+	}
+
+	app->leak.nsites = nsites;
+	app->leak.dropped = app->shm->dropped;
+
+	// partial selection sort by bytes
+	for(unsigned t = 0; (t < LEAK_TOP) && (t < nsites); t++)
+	{
+		unsigned max = t;
+
+		for(unsigned s = t + 1; s < nsites; s++)
+		{
+			if(usage[s].bytes > usage[max].bytes)
+			{
+				max = s;
+			}
+		}
+
+		const usage_t tmp_usage = usage[t];
+		void *tmp_site = sites[t];
+
+		usage[t] = usage[max];
+		sites[t] = sites[max];
+		usage[max] = tmp_usage;
+		sites[max] = tmp_site;
+
+		_leak_name(app->leak.top[t].name, sites[t]);
+		app->leak.top[t].usage = usage[t];
+	}
+
+	app->leak.valid = true;
+
+	_perf_deinit(&perf);
+
+	return 0;
+}
+
+int
+lv2lint_perf_wss(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	uint64_t base [WSS_MAX];
+	uint64_t used [WSS_MAX];
+	Dl_info plugin;
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	const int fd = open("/proc/self/clear_refs", O_WRONLY);
+	if(fd == -1)
+	{
+		return 0;
+	}
+
+	if(!dladdr(lilv_instance_get_descriptor(app->instance), &plugin)
+		|| !_perf_init(&perf, app, bufs) )
+	{
+		close(fd);
+		return 0;
+	}
+
+	memset(base, 0x0, sizeof(base));
+	memset(used, 0x0, sizeof(used));
+
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	bool valid = true;
+
+	// pages referenced by filling the inputs and reading smaps are subtracted
+	for(uint32_t i = 0; valid && (i < 2 * WSS_BLOCKS); i++)
+	{
+		const bool baseline = i < WSS_BLOCKS;
+
+		_perf_fill(&perf, STIM_noise);
+
+		valid = (pwrite(fd, "1", 1, 0) == 1);
+
+		if(!baseline)
+		{
+			lilv_instance_run(perf.instance, app->dsp.nsamples);
+		}
+
+		valid = valid && _wss_read(app, (uintptr_t)plugin.dli_fbase, "Referenced:",
+			baseline ? base : used);
+	}
+
+	if(valid)
+	{
+		for(wss_t w = 0; w < WSS_MAX; w++)
+		{
+			app->wss.kib[w] = used[w] > base[w]
+				? (double)(used[w] - base[w]) / WSS_BLOCKS
+				: 0.0;
+		}
+
+		app->wss.valid = true;
+	}
+
+	_perf_deinit(&perf);
+	close(fd);
+
+	return 0;
+}
+
+static size_t
+_cold_llc(void)
+{
+	size_t llc = 0;
+
+	for(unsigned i = 0; ; i++)
+	{
+		char path [64];
+		char unit = '\0';
+		size_t size = 0;
+
+		snprintf(path, sizeof(path),
+			"/sys/devices/system/cpu/cpu0/cache/index%u/size", i);
+
+		FILE *f = fopen(path, "r");
+		if(!f)
+		{
+			break;
+		}
+
+		const int n = fscanf(f, "%zu%c", &size, &unit);
+		fclose(f);
+
+		if(n < 1)
+		{
+			continue;
+		}
+
+		if(unit == 'K')
+		{
+			size <<= 10;
+		}
+		else if(unit == 'M')
+		{
+			size <<= 20;
+		}
+
+		if(size > llc)
+		{
+			llc = size;
+		}
+	}
+
+	return llc;
+}
+
+static void
+_cold_evict(volatile uint8_t *evict, size_t size)
+{
+	// written, thus dirty lines of the plugin are written back, too
+	for(size_t i = 0; i < size; i += COLD_LINE)
+	{
+		evict[i]++;
+	}
+}
+
+int
+lv2lint_perf_cold(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	uint64_t warm [COLD_BLOCKS];
+	uint64_t cold [COLD_BLOCKS];
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	const size_t llc = _cold_llc();
+	const size_t size = llc ? COLD_FACTOR * llc : COLD_FALLBACK;
+
+	uint8_t *evict = malloc(size);
+	if(!evict)
+	{
+		return 0;
+	}
+
+	memset(evict, 0x0, size);
+
+	if(!_perf_init(&perf, app, bufs))
+	{
+		free(evict);
+		return 0;
+	}
+
+	for(uint32_t i = 0; i < PERF_WARMUP; i++)
+	{
+		_perf_run(&perf, STIM_noise);
+	}
+
+	// interleaved, thus frequency scaling affects both alike
+	for(uint32_t i = 0; i < COLD_BLOCKS; i++)
+	{
+		warm[i] = _perf_run(&perf, STIM_noise);
+
+		// inputs are filled after evicting, like a host does after other plugins
+		_cold_evict(evict, size);
+		cold[i] = _perf_run(&perf, STIM_noise);
+	}
+
+	qsort(warm, COLD_BLOCKS, sizeof(uint64_t), _cmp);
+	qsort(cold, COLD_BLOCKS, sizeof(uint64_t), _cmp);
+
+	app->cold.evict = size;
+	app->cold.warm = _percentile(warm, COLD_BLOCKS, 0.50);
+	app->cold.cold = _percentile(cold, COLD_BLOCKS, 0.50);
+	app->cold.valid = true;
+
+	_perf_deinit(&perf);
+	free(evict);
+
+	return 0;
+}
+
+static void
+_soak_sample(app_t *app, unsigned i)
+{
+	rollup_t rollup;
+
+	if(!lv2lint_rollup(&rollup))
+	{
+		return;
+	}
+
+#ifdef HAS_MALLINFO2
+	const struct mallinfo2 mi = mallinfo2();
+	const int64_t heap = mi.uordblks + mi.hblkhd;
+#else
+	const int64_t heap = rollup.anon;
+#endif
+
+	const unsigned prev = app->soak.samples > 1 ? 1 : 0;
+
+	if(app->soak.samples && (heap < app->soak.heap[prev]) )
+	{
+		app->soak.monotonic = false;
+	}
+
+	app->soak.heap[i] = heap;
+	app->soak.rss[i] = rollup.rss;
+	app->soak.samples++;
+}
+
+static void
+_soak_occur(occurrence_t *occ, double t)
+{
+	if(occ->count++ == 0)
+	{
+		occ->first = t;
+	}
+}
+
+static float
+_soak_random(perf_t *perf)
+{
+	// xorshift32
+	perf->seed ^= perf->seed << 13;
+	perf->seed ^= perf->seed >> 17;
+	perf->seed ^= perf->seed << 5;
+
+	return (float)perf->seed / (float)UINT32_MAX;
+}
+
+#ifdef ENABLE_PTRACE_TESTS
+// only stop the tracer at syscall entries, rather than at entries and exits
+static bool
+_soak_filter(app_t *app)
+{
+	struct sock_filter filter [] = {
+		BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_TRACE)
+	};
+	struct sock_fprog prog = {
+		.len = sizeof(filter) / sizeof(filter[0]),
+		.filter = filter
+	};
+
+	if( (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == -1)
+		|| (syscall(SYS_seccomp, SECCOMP_SET_MODE_FILTER, 0, &prog) == -1) )
+	{
+		return false;
+	}
+
+	// installed for good, thus the tracer resumes with PTRACE_CONT until the
+	// traced child is gone
+	app->trace.seccomp = true;
+
+	return true;
+}
+#endif
+
+int
+lv2lint_perf_soak(app_t *app, void *data)
+{
+	buf_t *bufs = data;
+	bool syscalls [SYSCALL_MAX];
+	perf_t perf;
+
+	if(!app->instance)
+	{
+		return 1;
+	}
+
+	if(!_perf_init(&perf, app, bufs))
+	{
+		return 0;
+	}
+
+	float *min = calloc(perf.nports, sizeof(float));
+	float *max = calloc(perf.nports, sizeof(float));
+	bool *ctrl = calloc(perf.nports, sizeof(bool));
+
+	if(!min || !max || !ctrl)
+	{
+		free(min);
+		free(max);
+		free(ctrl);
+		_perf_deinit(&perf);
+		return 0;
+	}
+
+	for(uint32_t p = 0; p < perf.nports; p++)
+	{
+		const LilvPort *port = lilv_plugin_get_port_by_index(app->plugin, p);
+		LilvNode *lo = NULL;
+		LilvNode *hi = NULL;
+
+		if(!lilv_port_is_a(app->plugin, port, NODE(app, CORE__ControlPort))
+			|| !lilv_port_is_a(app->plugin, port, NODE(app, CORE__InputPort)) )
+		{
+			continue;
+		}
+
+		lilv_port_get_range(app->plugin, port, NULL, &lo, &hi);
+
+		if(lo && hi
+			&& (lilv_node_is_float(lo) || lilv_node_is_int(lo))
+			&& (lilv_node_is_float(hi) || lilv_node_is_int(hi)) )
+		{
+			min[p] = lilv_node_as_float(lo);
+			max[p] = lilv_node_as_float(hi);
+			ctrl[p] = true;
+		}
+
+		if(lo)
+		{
+			lilv_node_free(lo);
+		}
+
+		if(hi)
+		{
+			lilv_node_free(hi);
+		}
+	}
+
+	// the reports of the other tests are to stay untouched
+	const usage_t heap = app->shm->heap[PHASE_run];
+	const uint64_t traced = app->trace.syscalls;
+	const uint64_t futexes = app->trace.futexes;
+
+	memcpy(syscalls, app->syscall, sizeof(syscalls));
+	memset(app->syscall, 0x0, sizeof(app->syscall));
+
+	app->soak.seccomp = false;
+#ifdef ENABLE_PTRACE_TESTS
+	app->soak.seccomp = _soak_filter(app);
+#endif
+
+	const double deadline = 1e9 * app->dsp.nsamples / app->sample_rate;
+	const uint64_t duration = app->soak.duration * 1e9;
+	const uint64_t interval = SOAK_SAMPLE * 1e9;
+	const uint64_t t0 = _now();
+	uint64_t next = t0 + interval;
+	stim_t stim = STIM_noise;
+
+	app->soak.blocks = 0;
+	memset(app->soak.shift, 0x0, sizeof(app->soak.shift));
+	memset(app->soak.syscall, 0x0, sizeof(app->soak.syscall));
+	memset(&app->soak.overrun, 0x0, sizeof(app->soak.overrun));
+	app->soak.max = 0;
+	app->soak.samples = 0;
+	app->soak.monotonic = true;
+	_soak_sample(app, 0);
+
+	for(uint64_t b = 0; ; b++)
+	{
+		const uint64_t now = _now();
+
+		if(now - t0 >= duration)
+		{
+			break;
+		}
+
+		if(now >= next) // outside the enabled section
+		{
+			_soak_sample(app, 1);
+			next += interval;
+		}
+
+		if(b && (b % SOAK_STIM == 0) )
+		{
+			stim = (stim + 1) % STIM_MAX;
+		}
+
+		if(b % SOAK_CONTROL == 0)
+		{
+			for(uint32_t p = 0; p < perf.nports; p++)
+			{
+				if(ctrl[p])
+				{
+					bufs[p].port->wav[0] = min[p]
+						+ (max[p] - min[p]) * _soak_random(&perf);
+				}
+			}
+		}
+
+		_perf_fill(&perf, stim);
+
+		shm_enter(app->shm, PHASE_run);
+		shm_enable(app->shm);
+
+		const uint64_t ns = _perf_time(&perf, app->dsp.nsamples);
+
+		const unsigned mask = shm_disable(app->shm);
+		shm_leave(app->shm);
+
+		const double t = (now - t0) * 1e-9;
+
+		for(shift_t s = 0; s < SHIFT_MAX; s++)
+		{
+			if(mask & MASK(s))
+			{
+				_soak_occur(&app->soak.shift[s], t);
+			}
+		}
+
+		// set by the tracer while enabled
+		for(syscall_t call = 0; call < SYSCALL_MAX; call++)
+		{
+			if(app->syscall[call])
+			{
+				_soak_occur(&app->soak.syscall[call], t);
+				app->syscall[call] = false;
+			}
+		}
+
+		if(ns > deadline)
+		{
+			_soak_occur(&app->soak.overrun, t);
+		}
+
+		if(ns > app->soak.max)
+		{
+			app->soak.max = ns;
+		}
+
+		app->soak.blocks++;
+	}
+
+	app->soak.elapsed = (_now() - t0) * 1e-9;
+	_soak_sample(app, 1);
+
+	memcpy(app->syscall, syscalls, sizeof(syscalls));
+	app->trace.syscalls = traced;
+	app->trace.futexes = futexes;
+	app->shm->heap[PHASE_run] = heap;
+	app->soak.valid = true;
+
+	free(min);
+	free(max);
+	free(ctrl);
+	_perf_deinit(&perf);
+
+	return 0;
+}
@@ -3,6 +3,9 @@
  * SPDX-License-Identifier: Artistic-2.0
  */
 
+#include <math.h>
+#include <inttypes.h>
+
 #include <lv2lint/lv2lint.h>
 
 #include <lv2/patch/patch.h>
@@ -10,6 +13,8 @@
 #include <lv2/uri-map/uri-map.h>
 #include <lv2/state/state.h>
 #include <lv2/buf-size/buf-size.h>
+#include <lv2/log/log.h>
+#include <lv2/urid/urid.h>
 #include <lv2/ui/ui.h>
 #include <lv2/ui/ui.h>
 
@@ -83,6 +88,55 @@ _test_instantiation(app_t *app)
 	return ret;
 }
 
+static const ret_t *
+_test_instantiation_cost(app_t *app)
+{
+	static const ret_t ret_slow = {
+		.lnt = LINT_WARN,
+		.msg = "slow or heavy instantiation: %s",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Session load time is dominated by instantiation, load large "
+			"assets lazily or in the background, e.g. via the worker extension."
+	},
+	ret_cost = {
+		.lnt = LINT_NOTE,
+		.msg = "instantiation: %s",
+		.uri = LV2_CORE__Plugin,
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	if(!app->instance)
+	{
+		return ret;
+	}
+
+	const double ms = app->instantiation.ns * 1e-6;
+	const double mib = app->instantiation.read / (double)(1 << 20);
+	char *urn = NULL;
+	char buf [128];
+
+#ifdef ENABLE_PTRACE_TESTS
+	snprintf(buf, sizeof(buf), "%.1f ms, %u files, %.1f MiB read, "
+		"%u mmaps (%.1f MiB), %u threads", ms, app->instantiation.files, mib,
+		app->instantiation.mmaps, app->instantiation.mapped / (double)(1 << 20),
+		app->instantiation.threads);
+#else
+	snprintf(buf, sizeof(buf), "%.1f ms", ms);
+#endif
+	lv2lint_append_to(&urn, buf);
+
+	ret = (app->instantiation.limit && (ms > app->instantiation.limit) )
+		|| (mib > app->instantiation.budget)
+		? &ret_slow
+		: &ret_cost;
+
+	*app->urn = urn;
+
+	return ret;
+}
+
 #define DICT(NAME) \
 	[SHIFT_ ## NAME] = #NAME
 
@@ -108,6 +162,15 @@ static const char *mask_lbls [SHIFT_MAX] = {
 	DICT(usleep),
 	DICT(nanosleep),
 	DICT(clock_nanosleep),
+
+	[SHIFT_atomic_load] = "__atomic_load",
+	[SHIFT_atomic_store] = "__atomic_store",
+	[SHIFT_atomic_exchange] = "__atomic_exchange",
+	[SHIFT_atomic_compare_exchange] = "__atomic_compare_exchange",
+	[SHIFT_atomic_load_16] = "__atomic_load_16",
+	[SHIFT_atomic_store_16] = "__atomic_store_16",
+	[SHIFT_atomic_exchange_16] = "__atomic_exchange_16",
+	[SHIFT_atomic_compare_exchange_16] = "__atomic_compare_exchange_16",
 };
 
 static void
@@ -124,6 +187,69 @@ _serialize_mask(char **symbols, unsigned mask)
 	}
 }
 
+#ifdef ENABLE_LIBM_TESTS
+#define LIBM(NAME) \
+	[LIBM_ ## NAME] = #NAME
+
+static const char *libm_lbls [LIBM_MAX] = {
+	LIBM(powf),
+	LIBM(pow),
+	LIBM(expf),
+	LIBM(exp),
+	LIBM(exp2f),
+	LIBM(exp2),
+	LIBM(logf),
+	LIBM(log),
+	LIBM(log2f),
+	LIBM(log2),
+	LIBM(log10f),
+	LIBM(log10),
+	LIBM(sinf),
+	LIBM(sin),
+	LIBM(cosf),
+	LIBM(cos),
+	LIBM(tanf),
+	LIBM(tan),
+	LIBM(tanhf),
+	LIBM(tanh),
+	LIBM(atan2f),
+	LIBM(atan2),
+};
+
+static void
+_serialize_libm(char **symbols, const unsigned *libm)
+{
+	bool done [LIBM_MAX] = { false };
+
+	// list most frequently called functions first
+	while(true)
+	{
+		libm_t max = LIBM_MAX;
+
+		for(libm_t l = 0; l < LIBM_MAX; l++)
+		{
+			if(!done[l] && libm[l] && ( (max == LIBM_MAX) || (libm[l] > libm[max]) ) )
+			{
+				max = l;
+			}
+		}
+
+		if(max == LIBM_MAX)
+		{
+			break;
+		}
+
+		char buf [64];
+
+		snprintf(buf, sizeof(buf), "%.1f %s/sample",
+			(double)libm[max] / PORT_NSAMPLES, libm_lbls[max]);
+		lv2lint_append_to(symbols, buf);
+
+		done[max] = true;
+	}
+}
+#endif
+
 static const ret_t *
 _test_connect_port(app_t *app)
 {
@@ -133,6 +259,13 @@ _test_connect_port(app_t *app)
 		.uri = LV2_CORE__hardRTCapable,
 		.dsc = "Time waits for nothing."
 	},
+	ret_atomic = {
+		.lnt = LINT_WARN,
+		.msg = "non-lock-free atomics called: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Atomics on odd-sized or 16-byte types fall back to libatomic, "
+			"which serializes them with a hidden lock."
+	},
 	ret_crash = {
 		.lnt = LINT_FAIL,
 		.msg = "crashed",
@@ -146,15 +279,24 @@ _test_connect_port(app_t *app)
 	{
 		ret = &ret_crash;
 	}
-	else if(app->instance && app->forbidden.connect_port)
+	else if(app->instance && (app->forbidden.connect_port & ~MASK_ATOMIC) )
 	{
 		char *symbols = NULL;
 
-		_serialize_mask(&symbols, app->forbidden.connect_port);
+		_serialize_mask(&symbols, app->forbidden.connect_port & ~MASK_ATOMIC);
 
 		*app->urn = symbols;
 		ret = &ret_nonrt;
 	}
+	else if(app->instance && (app->forbidden.connect_port & MASK_ATOMIC) )
+	{
+		char *symbols = NULL;
+
+		_serialize_mask(&symbols, app->forbidden.connect_port & MASK_ATOMIC);
+
+		*app->urn = symbols;
+		ret = &ret_atomic;
+	}
 
 	return ret;
 }
@@ -168,12 +310,29 @@ _test_run(app_t *app)
 		.uri = LV2_CORE__hardRTCapable,
 		.dsc = "Time waits for nothing."
 	},
+	ret_atomic = {
+		.lnt = LINT_WARN,
+		.msg = "non-lock-free atomics called: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Atomics on odd-sized or 16-byte types fall back to libatomic, "
+			"which serializes them with a hidden lock."
+	},
 	ret_crash = {
 		.lnt = LINT_FAIL,
 		.msg = "crashed",
 		.uri = LV2_CORE__Plugin,
 		.dsc = "Well - fix your plugin."
 	};
+#ifdef ENABLE_LIBM_TESTS
+	static const ret_t ret_libm = {
+		.lnt = LINT_NOTE,
+		.msg = "transcendental libm functions called: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Transcendental functions are amongst the most expensive operations "
+			"per sample, consider approximations, lookup tables or computing them "
+			"once per block."
+	};
+#endif
 
 	const ret_t *ret = NULL;
 
@@ -181,1517 +340,3466 @@ _test_run(app_t *app)
 	{
 		ret = &ret_crash;
 	}
-	else if(app->instance && app->forbidden.run)
+	else if(app->instance && (app->forbidden.run & ~MASK_ATOMIC) )
 	{
 		char *symbols = NULL;
 
-		_serialize_mask(&symbols, app->forbidden.run);
+		_serialize_mask(&symbols, app->forbidden.run & ~MASK_ATOMIC);
 
 		*app->urn = symbols;
 		ret = &ret_nonrt;
 	}
+	else if(app->instance && (app->forbidden.run & MASK_ATOMIC) )
+	{
+		char *symbols = NULL;
 
-	return ret;
-}
+		_serialize_mask(&symbols, app->forbidden.run & MASK_ATOMIC);
 
-static const ret_t *
-_test_work(app_t *app)
-{
-	static const ret_t ret_crash = {
-		.lnt = LINT_FAIL,
-		.msg = "crashed",
-		.uri = LV2_CORE__Plugin,
-		.dsc = "Well - fix your plugin."
-	};
+		*app->urn = symbols;
+		ret = &ret_atomic;
+	}
+#ifdef ENABLE_LIBM_TESTS
+	else if(app->instance)
+	{
+		char *symbols = NULL;
 
-	const ret_t *ret = NULL;
+		_serialize_libm(&symbols, app->libm);
 
-	if(app->status.work)
-	{
-		ret = &ret_crash;
+		if(symbols)
+		{
+			*app->urn = symbols;
+			ret = &ret_libm;
+		}
 	}
+#endif
 
 	return ret;
 }
 
+#define PHASE(NAME) \
+	[PHASE_ ## NAME] = #NAME
+
+static const char *phase_lbls [PHASE_MAX] = {
+	PHASE(instantiate),
+	PHASE(connect_port),
+	PHASE(activate),
+	PHASE(run),
+	PHASE(work),
+	PHASE(work_response),
+	PHASE(deactivate),
+	PHASE(cleanup)
+};
+
 static const ret_t *
-_test_work_response(app_t *app)
+_test_mempool(app_t *app)
 {
-	static const ret_t ret_nonrt= {
+	static const ret_t ret_sleepy = {
 		.lnt = LINT_FAIL,
-		.msg = "non-realtime function called: %s",
+		.msg = "sleeping rtmempool functions called in run(): %s",
 		.uri = LV2_CORE__hardRTCapable,
-		.dsc = "Time waits for nothing."
+		.dsc = "Pools must only be created, destroyed or grown in non-realtime "
+			"threads, use allocate_atomic in run()."
 	},
-	ret_crash = {
-		.lnt = LINT_FAIL,
-		.msg = "crashed",
-		.uri = LV2_CORE__Plugin,
-		.dsc = "Well - fix your plugin."
+	ret_exhausted = {
+		.lnt = LINT_WARN,
+		.msg = "rtmempool exhausted in run(): %s",
+		.uri = LV2_RTSAFE_MEMORY_POOL_URI,
+		.dsc = "Preallocate enough chunks for the worst case."
+	},
+	ret_budget = {
+		.lnt = LINT_WARN,
+		.msg = "rtmempool usage in run() exceeds budget: %s",
+		.uri = LV2_RTSAFE_MEMORY_POOL_URI,
+		.dsc = "The plugin draws more memory per run than configured via "
+			"--pool-budget."
+	},
+	ret_usage = {
+		.lnt = LINT_NOTE,
+		.msg = "memory drawn from rtmempool vs. heap: %s",
+		.uri = LV2_RTSAFE_MEMORY_POOL_URI,
+		.dsc = "Memory drawn from the heap in realtime phases is better drawn "
+			"from the pool."
 	};
 
 	const ret_t *ret = NULL;
 
-	if(app->status.work_response)
+	if(!app->instance || !app->pool.offered)
 	{
-		ret = &ret_crash;
+		return ret;
 	}
-	else if(app->instance && app->forbidden.work_response)
+
+	char *urn = NULL;
+
+	for(phase_t phase = PHASE_NONE + 1; phase < PHASE_MAX; phase++)
 	{
-		char *symbols = NULL;
+		const usage_t *pool = &app->pool.usage[phase];
+		const usage_t *heap = &app->shm->heap[phase];
+		char buf [128];
 
-		_serialize_mask(&symbols, app->forbidden.work_response);
+		if(!pool->count && !app->pool.failed[phase]
+			&& ( (phase == PHASE_instantiate) || !heap->count ) )
+		{
+			continue;
+		}
 
-		*app->urn = symbols;
-		ret = &ret_nonrt;
+		int len = snprintf(buf, sizeof(buf), "%s: pool %u (%zu bytes)",
+			phase_lbls[phase], pool->count, pool->bytes);
+
+		if(app->pool.failed[phase])
+		{
+			len += snprintf(&buf[len], sizeof(buf) - len, ", %u failed",
+				app->pool.failed[phase]);
+		}
+
+		if(phase != PHASE_instantiate) // heap usage there includes loading the plugin
+		{
+			snprintf(&buf[len], sizeof(buf) - len, ", heap %u (%zu bytes)",
+				heap->count, heap->bytes);
+		}
+
+		lv2lint_append_to(&urn, buf);
+	}
+
+	if(app->pool.sleepy[PHASE_run])
+	{
+		ret = &ret_sleepy;
+	}
+	else if(app->pool.failed[PHASE_run])
+	{
+		ret = &ret_exhausted;
+	}
+	else if(app->pool.budget
+		&& (app->pool.usage[PHASE_run].bytes > app->pool.budget) )
+	{
+		ret = &ret_budget;
+	}
+	else if(urn)
+	{
+		ret = &ret_usage;
+	}
+
+	if(ret)
+	{
+		*app->urn = urn;
+	}
+	else
+	{
+		free(urn);
 	}
 
 	return ret;
 }
 
+#define HOST(NAME) \
+	[HOST_ ## NAME] = #NAME
+
+static const char *host_lbls [HOST_MAX] = {
+	HOST(map),
+	HOST(unmap),
+	HOST(log),
+	HOST(schedule_work),
+	HOST(respond)
+};
+
 static const ret_t *
-_test_state_restore(app_t *app)
+_test_host_calls(app_t *app)
 {
-	static const ret_t ret_crash = {
-		.lnt = LINT_FAIL,
-		.msg = "crashed",
-		.uri = LV2_STATE__State,
-		.dsc = "Well - fix your plugin."
+	static const ret_t ret_mapped = {
+		.lnt = LINT_WARN,
+		.msg = "new URIDs mapped in run(): %s",
+		.uri = LV2_URID__map,
+		.dsc = "Mapping a new URI may lock and allocate in the host, map all URIs "
+			"needed in run() at instantiation."
+	},
+	ret_logged = {
+		.lnt = LINT_WARN,
+		.msg = "non-trace messages logged in run(): %s",
+		.uri = LV2_LOG__log,
+		.dsc = "Only log:Trace is meant to be used from realtime threads, log "
+			"errors, warnings and notes from the worker or at instantiation."
+	},
+	ret_calls = {
+		.lnt = LINT_NOTE,
+		.msg = "host features called: %s",
+		.uri = LV2_CORE__Feature,
+		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	if(app->status.state_restore)
+	if(!app->instance)
 	{
-		ret = &ret_crash;
+		return ret;
 	}
 
-	return ret;
-}
+	char *urn = NULL;
 
-static const ret_t *
-_test_activate(app_t *app)
-{
-	static const ret_t ret_crash = {
-		.lnt = LINT_FAIL,
-		.msg = "crashed",
-		.uri = LV2_CORE__Plugin,
-		.dsc = "Well - fix your plugin."
-	};
+	for(phase_t phase = PHASE_NONE + 1; phase < PHASE_MAX; phase++)
+	{
+		for(host_t host = 0; host < HOST_MAX; host++)
+		{
+			const unsigned calls = app->host.calls[phase][host];
+			char buf [128];
 
-	const ret_t *ret = NULL;
+			if(!calls)
+			{
+				continue;
+			}
 
-	if(app->status.activate)
+			int len = snprintf(buf, sizeof(buf), "%s: %u x %s",
+				phase_lbls[phase], calls, host_lbls[host]);
+
+			if( (host == HOST_map) && app->host.mapped[phase])
+			{
+				snprintf(&buf[len], sizeof(buf) - len, " (%u new)",
+					app->host.mapped[phase]);
+			}
+			else if( (host == HOST_log) && app->host.untraced[phase])
+			{
+				snprintf(&buf[len], sizeof(buf) - len, " (%u not log:Trace)",
+					app->host.untraced[phase]);
+			}
+
+			lv2lint_append_to(&urn, buf);
+		}
+	}
+
+	if(app->host.mapped[PHASE_run])
 	{
-		ret = &ret_crash;
+		ret = &ret_mapped;
+	}
+	else if(app->host.untraced[PHASE_run])
+	{
+		ret = &ret_logged;
+	}
+	else if(urn)
+	{
+		ret = &ret_calls;
+	}
+
+	if(ret)
+	{
+		*app->urn = urn;
+	}
+	else
+	{
+		free(urn);
 	}
 
 	return ret;
 }
 
+#define STIM(NAME) \
+	[STIM_ ## NAME] = #NAME
+
+static const char *stim_lbls [STIM_MAX] = {
+	STIM(silence),
+	STIM(noise),
+	STIM(sine)
+};
+
 static const ret_t *
-_test_deactivate(app_t *app)
+_test_dsp_load(app_t *app)
 {
 	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
 		.msg = "crashed",
 		.uri = LV2_CORE__Plugin,
 		.dsc = "Well - fix your plugin."
+	},
+	ret_fail = {
+		.lnt = LINT_FAIL,
+		.msg = "DSP load above threshold: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "The plugin uses more of the realtime budget than configured via "
+			"--dsp-fail."
+	},
+	ret_warn = {
+		.lnt = LINT_WARN,
+		.msg = "DSP load above threshold: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "The plugin uses more of the realtime budget than configured via "
+			"--dsp-warn."
+	},
+	ret_load = {
+		.lnt = LINT_NOTE,
+		.msg = "DSP load: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Mean, median, 99th percentile and maximal nanoseconds per sample "
+			"and the mean share of one core's realtime budget."
 	};
 
 	const ret_t *ret = NULL;
 
-	if(app->status.deactivate)
+	if(app->status.dsp)
 	{
-		ret = &ret_crash;
+		return &ret_crash;
 	}
 
-	return ret;
-}
-
-#ifdef ENABLE_PTRACE_TESTS
-static const ret_t *
-_test_syscall(app_t *app)
-{
-	static const ret_t ret_nonrt= {
-		.lnt = LINT_FAIL,
-		.msg = "syscalls have been invoked in realtime context: %s",
-		.uri = LV2_CORE__hardRTCapable,
-		.dsc = "Time waits for nothing."
-	};
-
-	const ret_t *ret = NULL;
-
 	if(!app->instance)
 	{
 		return ret;
 	}
 
 	char *urn = NULL;
+	double load = 0.0;
 
-	for(syscall_t call = 0; call < SYSCALL_MAX; call++)
+	for(stim_t stim = 0; stim < STIM_MAX; stim++)
 	{
-		if(app->syscall[call])
+		const dsp_t *dsp = &app->dsp.stim[stim];
+		char buf [128];
+
+		if(!dsp->valid)
 		{
-			char buf [64];
+			continue;
+		}
 
-			snprintf(buf, sizeof(buf), "%3d: %s", call, syscall_to_name(call));
-			lv2lint_append_to(&urn, buf);
+		const double percent = dsp->mean * app->sample_rate * 1e-9 * 100.0;
+
+		if(percent > load)
+		{
+			load = percent;
 		}
+
+		snprintf(buf, sizeof(buf),
+			"%s: mean %.1f, p50 %.1f, p99 %.1f, max %.1f ns/sample (%.2f%% of one core)",
+			stim_lbls[stim], dsp->mean, dsp->p50, dsp->p99, dsp->max, percent);
+		lv2lint_append_to(&urn, buf);
 	}
 
-	if(urn)
+	if(!urn)
 	{
-		*app->urn = urn;
-		ret = &ret_nonrt;
+		return ret;
+	}
+
+	if(app->dsp.fail && (load > app->dsp.fail) )
+	{
+		ret = &ret_fail;
 	}
+	else if(app->dsp.warn && (load > app->dsp.warn) )
+	{
+		ret = &ret_warn;
+	}
+	else
+	{
+		ret = &ret_load;
+	}
+
+	*app->urn = urn;
 
 	return ret;
 }
-#endif
 
-#ifdef ENABLE_ELF_TESTS
-static const ret_t *
-_test_symbols(app_t *app)
+static inline double
+_jitter_upper(uint32_t bin)
 {
-	static const ret_t ret_symbols = {
-		.lnt = LINT_FAIL,
-		.msg = "binary exports superfluous globally visible symbols: %s",
-		.uri = LV2_CORE__binary,
-		.dsc = "Plugin binaries must not export any globally visible symbols "
-			 "but lv2_descriptor. You may well have forgotten to compile "
-			 "with -fvisibility=hidden."
-	};
+	return exp2( (double)(bin + 1) / JITTER_SUB);
+}
 
-	const ret_t *ret = NULL;
+static double
+_jitter_percentile(app_t *app, uint32_t total, double p)
+{
+	const uint32_t thresh = ceil(p * total);
+	uint32_t sum = 0;
 
-	const LilvNode* node = lilv_plugin_get_library_uri(app->plugin);
-	if(node && lilv_node_is_uri(node))
+	for(uint32_t bin = 0; bin < JITTER_BINS; bin++)
 	{
-		const char *uri = lilv_node_as_uri(node);
-		if(uri)
+		sum += app->jitter.bins[bin];
+
+		if(sum >= thresh)
 		{
-			char *path = lilv_file_uri_parse(uri, NULL);
-			if(path)
-			{
-				char *symbols = NULL;
-				if(!test_visibility(app, path, app->plugin_uri, "lv2_descriptor", &symbols))
-				{
-					*app->urn = symbols;
-					ret = &ret_symbols;
-				}
-				else if(symbols)
-				{
-					free(symbols);
-				}
+			const double upper = _jitter_upper(bin);
 
-				lilv_free(path);
-			}
+			return upper < app->jitter.max ? upper : app->jitter.max;
 		}
 	}
 
-	return ret;
+	return app->jitter.max;
 }
 
 static const ret_t *
-_test_fork(app_t *app)
+_test_jitter(app_t *app)
 {
-	static const ret_t ret_fork = {
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	},
+	ret_spikes = {
 		.lnt = LINT_WARN,
-		.msg = "binary has a symbol reference to the 'fork' function",
-		.uri = LV2_CORE__binary,
-		.dsc = "Plugin binaries must not call 'fork', as it may interrupt "
-			"the whole realtime plugin graph and lead to unwanted xruns."
+		.msg = "run() spikes above block deadline limit: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Occasional expensive blocks, e.g. due to lazy allocation, periodic "
+			"FFT frames or cleanup, cause dropouts long before the mean load does, "
+			"spread such work evenly across blocks."
+	},
+	ret_jitter = {
+		.lnt = LINT_NOTE,
+		.msg = "run() jitter: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Log-scale histogram of run() durations per block."
 	};
 
 	const ret_t *ret = NULL;
 
-	const LilvNode* node = lilv_plugin_get_library_uri(app->plugin);
-	if(node && lilv_node_is_uri(node))
+	if(app->status.jitter)
 	{
-		const char *uri = lilv_node_as_uri(node);
-		if(uri)
+		return &ret_crash;
+	}
+
+	if(!app->instance || !app->jitter.blocks || !app->jitter.max)
+	{
+		return ret;
+	}
+
+	uint32_t total = 0;
+	uint32_t peak = 0;
+
+	for(uint32_t bin = 0; bin < JITTER_BINS; bin++)
+	{
+		total += app->jitter.bins[bin];
+
+		if(app->jitter.bins[bin] > peak)
 		{
-			char *path = lilv_file_uri_parse(uri, NULL);
-			if(path)
-			{
-				if(check_for_symbol(app, path, "fork"))
-				{
-					ret = &ret_fork;
-				}
+			peak = app->jitter.bins[bin];
+		}
+	}
 
-				lilv_free(path);
-			}
+	const double deadline = 1e9 * app->dsp.nsamples / app->sample_rate;
+	const double median = _jitter_percentile(app, total, 0.5);
+	const double p999 = _jitter_percentile(app, total, 0.999);
+	const double max = app->jitter.max;
+
+	char *urn = NULL;
+	char buf [128];
+
+	snprintf(buf, sizeof(buf),
+		"p50 %.1f us, p99.9 %.1f us, max %.1f us (%.1f%% of deadline), worst/median %.1f",
+		median * 1e-3, p999 * 1e-3, max * 1e-3, max / deadline * 100.0, max / median);
+	lv2lint_append_to(&urn, buf);
+
+	for(uint32_t bin = 0; bin < JITTER_BINS; bin++)
+	{
+		const uint32_t count = app->jitter.bins[bin];
+
+		if(!count)
+		{
+			continue;
 		}
+
+		char bar [41];
+		const uint32_t len = ceil(40.0 * count / peak);
+
+		memset(bar, '#', len);
+		bar[len] = '\0';
+
+		snprintf(buf, sizeof(buf), "%9.1f us - %9.1f us: %8"PRIu32" %s",
+			exp2( (double)bin / JITTER_SUB) * 1e-3, _jitter_upper(bin) * 1e-3,
+			count, bar);
+		lv2lint_append_to(&urn, buf);
+	}
+
+	if(max > deadline * app->jitter.limit / 100.0)
+	{
+		ret = &ret_spikes;
+	}
+	else
+	{
+		ret = &ret_jitter;
 	}
 
+	*app->urn = urn;
+
 	return ret;
 }
 
+#define DENORMAL_RATIO 2.0 // tolerated tail to steady-state cost
+#define DENORMAL_FLOOR 2.0 // ns per sample, smaller differences are timer noise
+
 static const ret_t *
-_test_linking(app_t *app)
+_test_denormal(app_t *app)
 {
-	static const ret_t ret_symbols = {
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	},
+	ret_tail = {
 		.lnt = LINT_WARN,
-		.pck = LINT_NOTE,
-		.msg = "binary links to non-whitelisted shared libraries: %s",
-		.uri = LV2_CORE__binary,
-		.dsc = "The ideal plugin dynamically links maximally to libc, libm, librt, "
-			"libstdc++, libgcc_s."
+		.msg = "cost rises after input went silent: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Decaying feedback paths (filters, reverbs, delays) which do not "
+			"flush denormals get dramatically slower once the input is silent, "
+			"enable flush-to-zero or add a tiny offset."
 	},
-	ret_libstdcpp = {
+	ret_subnormal = {
 		.lnt = LINT_WARN,
-		.pck = LINT_NOTE,
-		.msg = "binary links to C++ libraries: %s",
-		.uri = LV2_CORE__binary,
-		.dsc = "C++ ABI incompatibilities between host and plugin are to be expected."
+		.msg = "subnormal output values after input went silent: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Subnormal values leaking from decaying feedback paths slow down "
+			"the plugin itself and every plugin downstream."
+	},
+	ret_denormal = {
+		.lnt = LINT_NOTE,
+		.msg = "silent tail cost: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	static const char *whitelist [] = {
-		"libc",
-		"libm",
-		"librt",
-		"libstdc++",
-		"libgcc_s"
-	};
-	const unsigned n_whitelist = sizeof(whitelist) / sizeof(const char *);
+	if(app->status.denormal)
+	{
+		return &ret_crash;
+	}
 
-	static const char *graylist [] = {
-		"libstdc++",
-		"libgcc_s"
-	};
-	const unsigned n_graylist = sizeof(graylist) / sizeof(const char *);
+	if(!app->instance || !app->denormal.valid || (app->denormal.steady <= 0.0) )
+	{
+		return ret;
+	}
 
-	const LilvNode* node = lilv_plugin_get_library_uri(app->plugin);
-	if(node && lilv_node_is_uri(node))
+	const double ratio = app->denormal.tail / app->denormal.steady;
+	char *urn = NULL;
+	char buf [128];
+
+	snprintf(buf, sizeof(buf),
+		"steady %.1f ns/sample, tail %.1f ns/sample at %.2f s (%.1fx)",
+		app->denormal.steady, app->denormal.tail, app->denormal.onset, ratio);
+	lv2lint_append_to(&urn, buf);
+
+	if(app->denormal.subnormals)
 	{
-		const char *uri = lilv_node_as_uri(node);
-		if(uri)
-		{
-			char *path = lilv_file_uri_parse(uri, NULL);
-			if(path)
-			{
-				char *libraries = NULL;
-				if(!test_shared_libraries(app, path, app->plugin_uri,
-					whitelist, n_whitelist,
-					NULL, 0,
-					&libraries))
-				{
-					*app->urn = libraries;
-					ret = &ret_symbols;
-				}
-				else if(!test_shared_libraries(app, path, app->plugin_uri,
-					NULL, 0,
-					graylist, n_graylist,
-					&libraries))
-				{
-					*app->urn = libraries;
-					ret = &ret_libstdcpp;
-				}
-				else if(libraries)
-				{
-					free(libraries);
-				}
+		snprintf(buf, sizeof(buf), "%"PRIu64" subnormal output samples",
+			app->denormal.subnormals);
+		lv2lint_append_to(&urn, buf);
+	}
 
-				lilv_free(path);
-			}
-		}
+	if( (ratio > DENORMAL_RATIO)
+		&& (app->denormal.tail - app->denormal.steady > DENORMAL_FLOOR) )
+	{
+		ret = &ret_tail;
+	}
+	else if(app->denormal.subnormals)
+	{
+		ret = &ret_subnormal;
+	}
+	else
+	{
+		ret = &ret_denormal;
 	}
 
+	*app->urn = urn;
+
 	return ret;
 }
-#endif
 
 static const ret_t *
-_test_verification(app_t *app)
+_test_overrun(app_t *app)
 {
-	static const ret_t ret_verification = {
+	static const ret_t ret_overrun = {
 		.lnt = LINT_FAIL,
-		.msg = "failed lilv_plugin_verify",
-		.uri = LV2_CORE_URI,
-		.dsc = NULL
+		.msg = "port buffer overrun: %s",
+		.uri = LV2_CORE__Port,
+		.dsc = "Plugins must not access port buffers beyond the block length for "
+			"audio/CV ports or beyond the announced capacity for atom ports."
 	};
 
 	const ret_t *ret = NULL;
 
-	if(!lilv_plugin_verify(app->plugin))
+	if(!app->fault.caught)
 	{
-		ret = &ret_verification;
+		return ret;
+	}
+
+	for(uint32_t p = 0; p < app->nbufs; p++)
+	{
+		const buf_t *buf = &app->bufs[p];
+		const uintptr_t end = (uintptr_t)buf->port + buf->size;
+
+		// faults in the guard page following the buffer
+		if( (app->fault.addr < end)
+			|| (app->fault.addr >= (uintptr_t)buf->map + buf->map_size) )
+		{
+			continue;
+		}
+
+		const LilvPort *port = lilv_plugin_get_port_by_index(app->plugin, p);
+		const LilvNode *symbol = lilv_port_get_symbol(app->plugin, port);
+		char *urn = NULL;
+		char buf_lbl [128];
+
+		int len = snprintf(buf_lbl, sizeof(buf_lbl), "port %"PRIu32" (%s) overrun by %"PRIuPTR" bytes",
+			p, lilv_node_as_string(symbol), app->fault.addr - end + 1);
+
+		if(app->fault.phase != PHASE_NONE)
+		{
+			snprintf(&buf_lbl[len], sizeof(buf_lbl) - len, " in %s",
+				phase_lbls[app->fault.phase]);
+		}
+
+		lv2lint_append_to(&urn, buf_lbl);
+
+		ret = &ret_overrun;
+		*app->urn = urn;
+		break;
 	}
 
 	return ret;
 }
 
 static const ret_t *
-_test_name(app_t *app)
+_test_counters(app_t *app)
 {
-	static const ret_t ret_name_not_found = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "doap:name not found",
+		.msg = "crashed",
 		.uri = LV2_CORE__Plugin,
-		.dsc = NULL
+		.dsc = "Well - fix your plugin."
 	},
-	ret_name_not_a_string = {
-		.lnt = LINT_FAIL,
-		.msg = "doap:name not a string",
-		.uri = LILV_NS_DOAP"name",
-		.dsc = NULL
+	ret_unavailable = {
+		.lnt = LINT_NOTE,
+		.msg = "performance counters unavailable: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "perf_event_open(2) is restricted by kernel.perf_event_paranoid or "
+			"not supported on this machine, e.g. inside virtual machines."
 	},
-	ret_name_empty = {
-		.lnt = LINT_FAIL,
-		.msg = "doap:name empty",
-		.uri = LILV_NS_DOAP"name",
-		.dsc = NULL
+	ret_counters = {
+		.lnt = LINT_NOTE,
+		.msg = "performance counters of run(): %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Low IPC with many cache misses per sample hints at memory-bound, "
+			"high IPC at compute-bound processing."
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *name_node = lilv_plugin_get_name(app->plugin);
-	if(name_node)
+	if(!app->counters.enabled)
 	{
-		if(lilv_node_is_string(name_node))
-		{
-			const char *name = lilv_node_as_string(name_node);
-			if(!name)
-			{
-				ret = &ret_name_empty;
-			}
-		}
-		else // !is_string
-		{
-			ret = &ret_name_not_a_string;
-		}
-		lilv_node_free(name_node);
+		return ret;
 	}
-	else // !name_node
+
+	if(app->status.counters)
 	{
-		ret = &ret_name_not_found;
+		return &ret_crash;
 	}
 
-	return ret;
-}
+	if(!app->instance)
+	{
+		return ret;
+	}
 
-static const ret_t *
-_test_license(app_t *app)
-{
-	static const ret_t ret_license_not_found = {
-		.lnt = LINT_WARN,
-		.msg = "doap:license not found",
-		.uri = LV2_CORE__Plugin,
-		.dsc = NULL
-	},
-	ret_license_not_a_uri = {
+	const uint64_t *value = app->counters.value;
+	const bool *avail = app->counters.avail;
+	const double samples = app->counters.samples;
+	char *urn = NULL;
+	char buf [128];
+
+	if(!app->counters.valid)
+	{
+		snprintf(buf, sizeof(buf), "%s (perf_event_paranoid=%d)",
+			strerror(app->counters.error), app->counters.paranoid);
+		lv2lint_append_to(&urn, buf);
+
+		ret = &ret_unavailable;
+		*app->urn = urn;
+
+		return ret;
+	}
+
+	if(avail[COUNTER_cycles])
+	{
+		snprintf(buf, sizeof(buf), "%.1f cycles/sample",
+			value[COUNTER_cycles] / samples);
+		lv2lint_append_to(&urn, buf);
+
+		if(avail[COUNTER_instructions] && value[COUNTER_cycles])
+		{
+			snprintf(buf, sizeof(buf), "IPC %.2f",
+				(double)value[COUNTER_instructions] / value[COUNTER_cycles]);
+			lv2lint_append_to(&urn, buf);
+		}
+	}
+	else
+	{
+		snprintf(buf, sizeof(buf), "no hardware counters (%s)",
+			strerror(app->counters.error));
+		lv2lint_append_to(&urn, buf);
+	}
+
+	if(avail[COUNTER_cache_misses])
+	{
+		int len = snprintf(buf, sizeof(buf), "%.3f cache misses/sample",
+			value[COUNTER_cache_misses] / samples);
+
+		if(avail[COUNTER_cache_references] && value[COUNTER_cache_references])
+		{
+			snprintf(&buf[len], sizeof(buf) - len, " (%.1f%% of references)",
+				100.0 * value[COUNTER_cache_misses] / value[COUNTER_cache_references]);
+		}
+
+		lv2lint_append_to(&urn, buf);
+	}
+
+	if(avail[COUNTER_branch_misses])
+	{
+		snprintf(buf, sizeof(buf), "%.3f branch misses/sample",
+			value[COUNTER_branch_misses] / samples);
+		lv2lint_append_to(&urn, buf);
+	}
+
+	if(avail[COUNTER_context_switches])
+	{
+		snprintf(buf, sizeof(buf), "%"PRIu64" context switches",
+			value[COUNTER_context_switches]);
+		lv2lint_append_to(&urn, buf);
+	}
+
+	ret = &ret_counters;
+	*app->urn = urn;
+
+	return ret;
+}
+
+static const ret_t *
+_test_profile(app_t *app)
+{
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	},
+	ret_profile = {
+		.lnt = LINT_NOTE,
+		.msg = "run() profile: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Functions with most self time are where optimizations pay off, "
+			"feed the folded stacks to flamegraph tools for the full picture."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(!app->profile.path)
+	{
+		return ret;
+	}
+
+	if(app->status.profile)
+	{
+		return &ret_crash;
+	}
+
+	if(!app->instance || !app->profile.nsamples)
+	{
+		return ret;
+	}
+
+	char *urn = NULL;
+	char buf [PROFILE_NAME_MAX];
+
+	snprintf(buf, sizeof(buf), "%"PRIu32" of %"PRIu32" samples in plugin%s",
+		app->profile.hits, app->profile.nsamples,
+		app->profile.written ? "" : " (folded stacks not written)");
+	lv2lint_append_to(&urn, buf);
+
+	for(unsigned i = 0; i < PROFILE_TOP; i++)
+	{
+		if(!app->profile.top[i].name)
+		{
+			break;
+		}
+
+		snprintf(buf, sizeof(buf), "%s %.1f%%", app->profile.top[i].name,
+			100.0 * app->profile.top[i].count / app->profile.nsamples);
+		lv2lint_append_to(&urn, buf);
+	}
+
+	ret = &ret_profile;
+	*app->urn = urn;
+
+	return ret;
+}
+
+static const ret_t *
+_test_block(app_t *app)
+{
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed with varying block sizes",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Hosts may call run() with any n_samples up to the maximum block "
+			"length, including 0, unless restricted via bufsz: features."
+	},
+	ret_overrun = {
+		.lnt = LINT_FAIL,
+		.msg = "output written past n_samples: %s",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "run() must only touch the first n_samples of each buffer, the "
+			"remainder may belong to the host."
+	},
+	ret_block = {
+		.lnt = LINT_NOTE,
+		.msg = "block sizes: %s",
+		.uri = LV2_BUF_SIZE__boundedBlockLength,
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	if(app->status.block)
+	{
+		return &ret_crash;
+	}
+
+	if(!app->instance || !app->block.calls)
+	{
+		return ret;
+	}
+
+	char *urn = NULL;
+	char buf [128];
+
+	snprintf(buf, sizeof(buf), "%"PRIu32" calls with n_samples %"PRIu32"..%"PRIu32"%s",
+		app->block.calls, app->block.min, app->block.max,
+		app->block.fixed
+			? " (fixed)"
+			: app->block.pow2
+				? " (power of 2)"
+				: "");
+	lv2lint_append_to(&urn, buf);
+
+	if(app->block.overruns)
+	{
+		snprintf(buf, sizeof(buf), "%"PRIu32" calls overran, first at n_samples=%"PRIu32,
+			app->block.overruns, app->block.overrun);
+		lv2lint_append_to(&urn, buf);
+
+		ret = &ret_overrun;
+	}
+
+	if(app->block.valid)
+	{
+		const double share = app->block.t_max > 0.0
+			? 100.0 * app->block.overhead / app->block.t_max
+			: 0.0;
+
+		snprintf(buf, sizeof(buf), "%.0f ns at n_samples=%"PRIu32", %.0f ns at "
+			"n_samples=%"PRIu32", fixed overhead ~%.0f ns per call (%.1f%%)",
+			app->block.t_small, app->block.small, app->block.t_max, app->block.max,
+			app->block.overhead, share);
+		lv2lint_append_to(&urn, buf);
+	}
+
+	if(!ret)
+	{
+		ret = &ret_block;
+	}
+
+	*app->urn = urn;
+
+	return ret;
+}
+
+#ifdef FPCR_MASK
+typedef struct _fpcr_lbl_t fpcr_lbl_t;
+
+struct _fpcr_lbl_t {
+	uint32_t mask;
+	const char *lbl;
+};
+
+static const fpcr_lbl_t fpcr_lbls [] = {
+#if defined(__SSE__)
+	{ 0x0040, "DAZ" },
+	{ 0x0080, "IM" },
+	{ 0x0100, "DM" },
+	{ 0x0200, "ZM" },
+	{ 0x0400, "OM" },
+	{ 0x0800, "UM" },
+	{ 0x1000, "PM" },
+	{ 0x6000, "RC" },
+	{ 0x8000, "FTZ" },
+#elif defined(__aarch64__)
+	{ 0x00000100, "IOE" },
+	{ 0x00000200, "DZE" },
+	{ 0x00000400, "OFE" },
+	{ 0x00000800, "UFE" },
+	{ 0x00001000, "IXE" },
+	{ 0x00008000, "IDE" },
+	{ 0x00080000, "FZ16" },
+	{ 0x00c00000, "RMode" },
+	{ 0x01000000, "FZ" },
+	{ 0x02000000, "DN" },
+	{ 0x04000000, "AHP" },
+#endif
+	{ 0, NULL }
+};
+
+static const ret_t *
+_test_fpcr(app_t *app)
+{
+	static const ret_t ret_fpcr = {
+		.lnt = LINT_WARN,
+		.msg = "floating-point control state changed: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "The floating-point control register (MXCSR/FPCR) belongs to the "
+			"host thread, flush-to-zero, denormals-are-zero or rounding modes "
+			"changed by a plugin affect every other plugin in the same thread, "
+			"restore the state before returning."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(!app->instance)
+	{
+		return ret;
+	}
+
+	char *urn = NULL;
+
+	for(phase_t phase = PHASE_NONE + 1; phase < PHASE_MAX; phase++)
+	{
+		const uint32_t changed = app->fpcr.changed[phase];
+		const uint32_t value = app->fpcr.value[phase];
+
+		for(const fpcr_lbl_t *lbl = fpcr_lbls; lbl->lbl; lbl++)
+		{
+			char buf [64];
+
+			if(!(changed & lbl->mask))
+			{
+				continue;
+			}
+
+			if( (lbl->mask & (lbl->mask - 1)) == 0) // single bit
+			{
+				snprintf(buf, sizeof(buf), "%s: %s %s", phase_lbls[phase], lbl->lbl,
+					(value & lbl->mask) ? "set" : "cleared");
+			}
+			else
+			{
+				snprintf(buf, sizeof(buf), "%s: %s changed", phase_lbls[phase],
+					lbl->lbl);
+			}
+
+			lv2lint_append_to(&urn, buf);
+		}
+	}
+
+	if(urn)
+	{
+		ret = &ret_fpcr;
+		*app->urn = urn;
+	}
+
+	return ret;
+}
+#endif
+
+static const ret_t *
+_test_work(app_t *app)
+{
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(app->status.work)
+	{
+		ret = &ret_crash;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_work_response(app_t *app)
+{
+	static const ret_t ret_nonrt= {
+		.lnt = LINT_FAIL,
+		.msg = "non-realtime function called: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Time waits for nothing."
+	},
+	ret_atomic = {
+		.lnt = LINT_WARN,
+		.msg = "non-lock-free atomics called: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Atomics on odd-sized or 16-byte types fall back to libatomic, "
+			"which serializes them with a hidden lock."
+	},
+	ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(app->status.work_response)
+	{
+		ret = &ret_crash;
+	}
+	else if(app->instance && (app->forbidden.work_response & ~MASK_ATOMIC) )
+	{
+		char *symbols = NULL;
+
+		_serialize_mask(&symbols, app->forbidden.work_response & ~MASK_ATOMIC);
+
+		*app->urn = symbols;
+		ret = &ret_nonrt;
+	}
+	else if(app->instance && (app->forbidden.work_response & MASK_ATOMIC) )
+	{
+		char *symbols = NULL;
+
+		_serialize_mask(&symbols, app->forbidden.work_response & MASK_ATOMIC);
+
+		*app->urn = symbols;
+		ret = &ret_atomic;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_state_restore(app_t *app)
+{
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_STATE__State,
+		.dsc = "Well - fix your plugin."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(app->status.state_restore)
+	{
+		ret = &ret_crash;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_activate(app_t *app)
+{
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(app->status.activate)
+	{
+		ret = &ret_crash;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_deactivate(app_t *app)
+{
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(app->status.deactivate)
+	{
+		ret = &ret_crash;
+	}
+
+	return ret;
+}
+
+#ifdef ENABLE_PTRACE_TESTS
+static const ret_t *
+_test_syscall(app_t *app)
+{
+	static const ret_t ret_nonrt= {
+		.lnt = LINT_FAIL,
+		.msg = "syscalls have been invoked in realtime context: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Time waits for nothing."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(!app->instance)
+	{
+		return ret;
+	}
+
+	char *urn = NULL;
+
+	for(syscall_t call = 0; call < SYSCALL_MAX; call++)
+	{
+		if(app->syscall[call])
+		{
+			char buf [64];
+
+			snprintf(buf, sizeof(buf), "%3d: %s", call, syscall_to_name(call));
+			lv2lint_append_to(&urn, buf);
+		}
+	}
+
+	if(urn)
+	{
+		*app->urn = urn;
+		ret = &ret_nonrt;
+	}
+
+	return ret;
+}
+#endif
+
+#ifdef ENABLE_ELF_TESTS
+static const ret_t *
+_test_symbols(app_t *app)
+{
+	static const ret_t ret_symbols = {
+		.lnt = LINT_FAIL,
+		.msg = "binary exports superfluous globally visible symbols: %s",
+		.uri = LV2_CORE__binary,
+		.dsc = "Plugin binaries must not export any globally visible symbols "
+			 "but lv2_descriptor. You may well have forgotten to compile "
+			 "with -fvisibility=hidden."
+	};
+
+	const ret_t *ret = NULL;
+
+	const LilvNode* node = lilv_plugin_get_library_uri(app->plugin);
+	if(node && lilv_node_is_uri(node))
+	{
+		const char *uri = lilv_node_as_uri(node);
+		if(uri)
+		{
+			char *path = lilv_file_uri_parse(uri, NULL);
+			if(path)
+			{
+				char *symbols = NULL;
+				if(!test_visibility(app, path, app->plugin_uri, "lv2_descriptor", &symbols))
+				{
+					*app->urn = symbols;
+					ret = &ret_symbols;
+				}
+				else if(symbols)
+				{
+					free(symbols);
+				}
+
+				lilv_free(path);
+			}
+		}
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_fork(app_t *app)
+{
+	static const ret_t ret_fork = {
+		.lnt = LINT_WARN,
+		.msg = "binary has a symbol reference to the 'fork' function",
+		.uri = LV2_CORE__binary,
+		.dsc = "Plugin binaries must not call 'fork', as it may interrupt "
+			"the whole realtime plugin graph and lead to unwanted xruns."
+	};
+
+	const ret_t *ret = NULL;
+
+	const LilvNode* node = lilv_plugin_get_library_uri(app->plugin);
+	if(node && lilv_node_is_uri(node))
+	{
+		const char *uri = lilv_node_as_uri(node);
+		if(uri)
+		{
+			char *path = lilv_file_uri_parse(uri, NULL);
+			if(path)
+			{
+				if(check_for_symbol(app, path, "fork"))
+				{
+					ret = &ret_fork;
+				}
+
+				lilv_free(path);
+			}
+		}
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_linking(app_t *app)
+{
+	static const ret_t ret_symbols = {
+		.lnt = LINT_WARN,
+		.pck = LINT_NOTE,
+		.msg = "binary links to non-whitelisted shared libraries: %s",
+		.uri = LV2_CORE__binary,
+		.dsc = "The ideal plugin dynamically links maximally to libc, libm, librt, "
+			"libstdc++, libgcc_s."
+	},
+	ret_libstdcpp = {
+		.lnt = LINT_WARN,
+		.pck = LINT_NOTE,
+		.msg = "binary links to C++ libraries: %s",
+		.uri = LV2_CORE__binary,
+		.dsc = "C++ ABI incompatibilities between host and plugin are to be expected."
+	};
+
+	const ret_t *ret = NULL;
+
+	static const char *whitelist [] = {
+		"libc",
+		"libm",
+		"librt",
+		"libstdc++",
+		"libgcc_s",
+		"libatomic"
+	};
+	const unsigned n_whitelist = sizeof(whitelist) / sizeof(const char *);
+
+	static const char *graylist [] = {
+		"libstdc++",
+		"libgcc_s"
+	};
+	const unsigned n_graylist = sizeof(graylist) / sizeof(const char *);
+
+	const LilvNode* node = lilv_plugin_get_library_uri(app->plugin);
+	if(node && lilv_node_is_uri(node))
+	{
+		const char *uri = lilv_node_as_uri(node);
+		if(uri)
+		{
+			char *path = lilv_file_uri_parse(uri, NULL);
+			if(path)
+			{
+				char *libraries = NULL;
+				if(!test_shared_libraries(app, path, app->plugin_uri,
+					whitelist, n_whitelist,
+					NULL, 0,
+					&libraries))
+				{
+					*app->urn = libraries;
+					ret = &ret_symbols;
+				}
+				else if(!test_shared_libraries(app, path, app->plugin_uri,
+					NULL, 0,
+					graylist, n_graylist,
+					&libraries))
+				{
+					*app->urn = libraries;
+					ret = &ret_libstdcpp;
+				}
+				else if(libraries)
+				{
+					free(libraries);
+				}
+
+				lilv_free(path);
+			}
+		}
+	}
+
+	return ret;
+}
+
+// separate from the linking test, as it concerns C++ plugins using std::atomic
+static const ret_t *
+_test_libatomic(app_t *app)
+{
+	static const ret_t ret_libatomic = {
+		.lnt = LINT_NOTE,
+		.msg = "binary links to libatomic: %s",
+		.uri = LV2_CORE__binary,
+		.dsc = "Atomics which are not lock-free are implemented with a hidden lock, "
+			"make sure they are not used in realtime threads."
+	};
+
+	const ret_t *ret = NULL;
+
+	static const char *hintlist [] = {
+		"libatomic"
+	};
+	const unsigned n_hintlist = sizeof(hintlist) / sizeof(const char *);
+
+	const LilvNode* node = lilv_plugin_get_library_uri(app->plugin);
+	if(node && lilv_node_is_uri(node))
+	{
+		const char *uri = lilv_node_as_uri(node);
+		if(uri)
+		{
+			char *path = lilv_file_uri_parse(uri, NULL);
+			if(path)
+			{
+				char *libraries = NULL;
+				if(!test_shared_libraries(app, path, app->plugin_uri,
+					NULL, 0,
+					hintlist, n_hintlist,
+					&libraries))
+				{
+					*app->urn = libraries;
+					ret = &ret_libatomic;
+				}
+				else if(libraries)
+				{
+					free(libraries);
+				}
+
+				lilv_free(path);
+			}
+		}
+	}
+
+	return ret;
+}
+#endif
+
+static const ret_t *
+_test_verification(app_t *app)
+{
+	static const ret_t ret_verification = {
+		.lnt = LINT_FAIL,
+		.msg = "failed lilv_plugin_verify",
+		.uri = LV2_CORE_URI,
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	if(!lilv_plugin_verify(app->plugin))
+	{
+		ret = &ret_verification;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_name(app_t *app)
+{
+	static const ret_t ret_name_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "doap:name not found",
+		.uri = LV2_CORE__Plugin,
+		.dsc = NULL
+	},
+	ret_name_not_a_string = {
+		.lnt = LINT_FAIL,
+		.msg = "doap:name not a string",
+		.uri = LILV_NS_DOAP"name",
+		.dsc = NULL
+	},
+	ret_name_empty = {
+		.lnt = LINT_FAIL,
+		.msg = "doap:name empty",
+		.uri = LILV_NS_DOAP"name",
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNode *name_node = lilv_plugin_get_name(app->plugin);
+	if(name_node)
+	{
+		if(lilv_node_is_string(name_node))
+		{
+			const char *name = lilv_node_as_string(name_node);
+			if(!name)
+			{
+				ret = &ret_name_empty;
+			}
+		}
+		else // !is_string
+		{
+			ret = &ret_name_not_a_string;
+		}
+		lilv_node_free(name_node);
+	}
+	else // !name_node
+	{
+		ret = &ret_name_not_found;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_license(app_t *app)
+{
+	static const ret_t ret_license_not_found = {
+		.lnt = LINT_WARN,
+		.msg = "doap:license not found",
+		.uri = LV2_CORE__Plugin,
+		.dsc = NULL
+	},
+	ret_license_not_a_uri = {
+		.lnt = LINT_FAIL,
+		.msg = "doap:license not a URI",
+		.uri = LILV_NS_DOAP"license",
+		.dsc = NULL
+	},
+#ifdef ENABLE_ONLINE_TESTS
+	ret_license_not_existing = {
+		.lnt = LINT_WARN,
+		.msg = "doap:license Web URL does not exist",
+		.uri = LILV_NS_DOAP"license",
+		.dsc = "It is good practice to have some online documentation at given URL."
+	},
+#endif
+	ret_license_empty = {
+		.lnt = LINT_FAIL,
+		.msg = "doap:license empty",
+		.uri = LILV_NS_DOAP"license",
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNode *license_node = lilv_world_get(app->world, lilv_plugin_get_uri(app->plugin), NODE(app, DOAP__license), NULL);
+	if (!license_node)
+	{
+		LilvNode *project_node = lilv_plugin_get_project(app->plugin);
+		if (project_node)
+		{
+			license_node = lilv_world_get(app->world, project_node, NODE(app, DOAP__license), NULL);
+		}
+	}
+
+	if(license_node)
+	{
+		if(lilv_node_is_uri(license_node))
+		{
+			const char *uri = lilv_node_as_uri(license_node);
+
+			if(!uri)
+			{
+				ret = &ret_license_empty;
+			}
+#ifdef ENABLE_ONLINE_TESTS
+			else if(is_url(uri))
+			{
+				const bool url_exists = !app->online || test_url(app, uri);
+
+				if(!url_exists)
+				{
+					ret = &ret_license_not_existing;
+				}
+			}
+#endif
+		}
+		else
+		{
+			ret = &ret_license_not_a_uri;
+		}
+		lilv_node_free(license_node);
+	}
+	else
+	{
+		ret = &ret_license_not_found;
+	}
+
+	return ret;
+}
+
+#define FOAF_DSC "You likely have not defined an lv2:project with " \
+	"a valid doap:maintainer or your plugin is not a subclass of doap:Project."
+
+static const ret_t *
+_test_author_name(app_t *app)
+{
+	static const ret_t ret_author_not_found = {
+		.lnt = LINT_WARN,
+		.msg = "foaf:name not found",
+		.uri = LV2_CORE__project,
+		.dsc = FOAF_DSC
+	},
+	ret_author_not_a_string = {
+		.lnt = LINT_FAIL,
+		.msg = "foaf:name not a string",
+		.uri = LILV_NS_FOAF"name",
+		.dsc = FOAF_DSC
+	},
+	ret_author_empty = {
+		.lnt = LINT_FAIL,
+		.msg = "foaf:name empty",
+		.uri = LILV_NS_FOAF"name",
+		.dsc = FOAF_DSC
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNode *author_name = lilv_plugin_get_author_name(app->plugin);
+	if(author_name)
+	{
+		if(lilv_node_is_string(author_name))
+		{
+			if(!lilv_node_as_string(author_name))
+			{
+				ret = &ret_author_empty;
+			}
+		}
+		else
+		{
+			ret = &ret_author_not_a_string;
+		}
+		lilv_node_free(author_name);
+	}
+	else
+	{
+		ret = &ret_author_not_found;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_author_email(app_t *app)
+{
+	static const ret_t ret_email_not_found = {
+		.lnt = LINT_WARN,
+		.msg = "foaf:mbox not found",
+		.uri = LV2_CORE__project,
+		.dsc = FOAF_DSC
+	},
+	ret_email_not_a_uri = {
+		.lnt = LINT_FAIL,
+		.msg = "foaf:mbox not a URI",
+		.uri = LILV_NS_FOAF"mbox",
+		.dsc = FOAF_DSC
+	},
+	ret_email_empty = {
+		.lnt = LINT_FAIL,
+		.msg = "foaf:mbox empty",
+		.uri = LILV_NS_FOAF"mbox",
+		.dsc = FOAF_DSC
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNode *author_email = lilv_plugin_get_author_email(app->plugin);
+	if(author_email)
+	{
+		if(lilv_node_is_uri(author_email))
+		{
+			if(!lilv_node_as_uri(author_email))
+			{
+				ret = &ret_email_empty;
+			}
+		}
+		else
+		{
+			ret = &ret_email_not_a_uri;
+		}
+		lilv_node_free(author_email);
+	}
+	else
+	{
+		ret = &ret_email_not_found;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_author_homepage(app_t *app)
+{
+	static const ret_t ret_homepage_not_found = {
+		.lnt = LINT_WARN,
+		.msg = "foaf:homepage not found",
+		.uri = LV2_CORE__project,
+		.dsc = FOAF_DSC
+	},
+	ret_homepage_not_a_uri = {
+		.lnt = LINT_FAIL,
+		.msg = "foaf:homepage not a URI",
+		.uri = LILV_NS_FOAF"homepage",
+		.dsc = FOAF_DSC
+	},
+#ifdef ENABLE_ONLINE_TESTS
+	ret_homepage_not_existing = {
+		.lnt = LINT_WARN,
+		.msg = "foaf:homepage Web URL does not exist",
+		.uri = LILV_NS_FOAF"homepage",
+		.dsc = FOAF_DSC
+	},
+#endif
+	ret_homepage_empty = {
+		.lnt = LINT_FAIL,
+		.msg = "foaf:homepage empty",
+		.uri = LILV_NS_FOAF"homepage",
+		.dsc = FOAF_DSC
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNode *author_homepage = lilv_plugin_get_author_homepage(app->plugin);
+	if(author_homepage)
+	{
+		if(lilv_node_is_uri(author_homepage))
+		{
+			const char *uri = lilv_node_as_uri(author_homepage);
+
+			if(!uri)
+			{
+				ret = &ret_homepage_empty;
+			}
+#ifdef ENABLE_ONLINE_TESTS
+			else if(is_url(uri))
+			{
+				const bool url_exists = !app->online || test_url(app, uri);
+
+				if(!url_exists)
+				{
+					ret = &ret_homepage_not_existing;
+				}
+			}
+#endif
+		}
+		else
+		{
+			ret = &ret_homepage_not_a_uri;
+		}
+		lilv_node_free(author_homepage);
+	}
+	else
+	{
+		ret = &ret_homepage_not_found;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_version_minor(app_t *app)
+{
+	static const ret_t ret_version_minor_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:minorVersion not found",
+		.uri = LV2_CORE__minorVersion,
+		.dsc = NULL
+	},
+	ret_version_minor_not_an_int = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:minorVersion not an integer",
+		.uri = LV2_CORE__minorVersion,
+		.dsc = NULL
+	},
+	ret_version_minor_unstable = {
+		.lnt = LINT_NOTE,
+		.msg = "lv2:minorVersion denotes an unstable version",
+		.uri = LV2_CORE__minorVersion,
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNodes *minor_version_nodes = lilv_plugin_get_value(app->plugin , NODE(app, CORE__minorVersion));
+	if(minor_version_nodes)
+	{
+		const LilvNode *minor_version_node = lilv_nodes_get_first(minor_version_nodes);
+		if(minor_version_node)
+		{
+			if(lilv_node_is_int(minor_version_node))
+			{
+				const int minor_version = lilv_node_as_int(minor_version_node);
+				if( (minor_version % 2 != 0) || (minor_version == 0) )
+				{
+					ret = &ret_version_minor_unstable;
+				}
+			}
+			else
+			{
+				ret = &ret_version_minor_not_an_int;
+			}
+		}
+		else
+		{
+			ret = &ret_version_minor_not_found;
+		}
+		lilv_nodes_free(minor_version_nodes);
+	}
+	else
+	{
+		ret = &ret_version_minor_not_found;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_version_micro(app_t *app)
+{
+	static const ret_t ret_version_micro_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:microVersion not found",
+		.uri = LV2_CORE__microVersion,
+		.dsc = NULL
+	},
+	ret_version_micro_not_an_int = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:microVersion not an integer",
+		.uri = LV2_CORE__microVersion,
+		.dsc = NULL
+	},
+	ret_version_micro_unstable = {
+		.lnt = LINT_NOTE,
+		.msg = "lv2:microVersion denotes an unstable version",
+		.uri = LV2_CORE__microVersion,
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNodes *micro_version_nodes = lilv_plugin_get_value(app->plugin , NODE(app, CORE__microVersion));
+	if(micro_version_nodes)
+	{
+		const LilvNode *micro_version_node = lilv_nodes_get_first(micro_version_nodes);
+		if(micro_version_node)
+		{
+			if(lilv_node_is_int(micro_version_node))
+			{
+				const int micro_version = lilv_node_as_int(micro_version_node);
+				if(micro_version % 2 != 0)
+				{
+					ret = &ret_version_micro_unstable;
+				}
+			}
+			else
+			{
+				ret = &ret_version_micro_not_an_int;
+			}
+		}
+		else
+		{
+			ret = &ret_version_micro_not_found;
+		}
+		lilv_nodes_free(micro_version_nodes);
+	}
+	else
+	{
+		ret = &ret_version_micro_not_found;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_project(app_t *app)
+{
+	static const ret_t ret_project_not_found = {
+		.lnt = LINT_NOTE,
+		.msg = "lv2:project not found",
+		.uri = LV2_CORE__project,
+		.dsc = NULL
+	},
+	ret_project_name_not_found = {
+		.lnt = LINT_WARN,
+		.msg = "lv2:project doap:name not found",
+		.uri = LV2_CORE__project,
+		.dsc = NULL
+	},
+	ret_project_name_not_a_string = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:project doap:name not a string",
+		.uri = LILV_NS_DOAP"name",
+		.dsc = NULL
+	},
+	ret_project_name_empty = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:project doap:name empty",
+		.uri = LILV_NS_DOAP"name",
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNode *project_node = lilv_plugin_get_project(app->plugin);
+	if(project_node)
+	{
+		LilvNode *project_name_node = lilv_world_get(app->world, project_node, NODE(app, DOAP__name), NULL);
+		if(project_name_node)
+		{
+			if(lilv_node_is_string(project_name_node))
+			{
+				if(!lilv_node_as_string(project_name_node))
+				{
+					ret = &ret_project_name_empty;
+				}
+			}
+			else
+			{
+				ret = &ret_project_name_not_a_string;
+			}
+			lilv_free(project_name_node);
+		}
+		else // !doap_name_node
+		{
+			ret = &ret_project_name_not_found;
+		}
+		lilv_node_free(project_node);
+	}
+	else // !project_node
+	{
+		ret = &ret_project_not_found;
+	}
+
+	return ret;
+}
+
+static inline bool
+_test_class_equals(const LilvPluginClass *base, const LilvPluginClass *class)
+{
+	return lilv_node_equals(
+		lilv_plugin_class_get_uri(base),
+		lilv_plugin_class_get_uri(class) );
+}
+
+static inline bool
+_test_class_match(const LilvPluginClass *base, const LilvPluginClass *class)
+{
+	if(_test_class_equals(base, class))
+	{
+		return true;
+	}
+
+	bool ret = false;
+	LilvPluginClasses *children= lilv_plugin_class_get_children(base);
+	if(children)
+	{
+		LILV_FOREACH(plugin_classes, itr, children)
+		{
+			const LilvPluginClass *child = lilv_plugin_classes_get(children, itr);
+			if(_test_class_match(child, class))
+			{
+				ret = true;
+				break;
+			}
+		}
+		lilv_plugin_classes_free(children);
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_class(app_t *app)
+{
+	static const ret_t ret_class_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "type not found",
+		.uri = LV2_CORE__Plugin,
+		.dsc = NULL
+	},
+	ret_class_is_base_class = {
+		.lnt = LINT_WARN,
+		.msg = "type is just lv2:Plugin",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "If you give the plugin a proper class, hosts can better sort them."
+	},
+	ret_class_not_valid = {
+		.lnt = LINT_FAIL,
+		.msg = "type <%s> not valid",
+		.uri = LV2_CORE__Plugin,
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	const LilvPluginClass *class = lilv_plugin_get_class(app->plugin);
+	if(class)
+	{
+		const LilvPluginClass *base = lilv_world_get_plugin_class(app->world);
+		if(_test_class_equals(base, class))
+		{
+			ret = &ret_class_is_base_class;
+		}
+		else if(!_test_class_match(base, class))
+		{
+			const LilvNode *class_uri = lilv_plugin_class_get_uri(class);
+			*app->urn = lv2lint_node_as_uri_strdup(class_uri);
+			ret = &ret_class_not_valid;
+		}
+	}
+	else // !class
+	{
+		ret = &ret_class_not_found;
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_features(app_t *app)
+{
+	static const ret_t ret_features_not_valid = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:[optional|required]Feature <%s> not valid",
+		.uri = LV2_CORE__Feature,
+		.dsc = "Make sure that the lv2:Feature is defined somewhere."
+	};
+
+	const ret_t *ret = NULL;
+
+	LilvNodes *features = lilv_world_find_nodes(app->world,
+		NULL, NODE(app, RDF__type), NODE(app, CORE__Feature));
+	if(features)
+	{
+		LilvNodes *supported = lilv_plugin_get_supported_features(app->plugin);
+		if(supported)
+		{
+			LILV_FOREACH(nodes, itr, supported)
+			{
+				const LilvNode *node = lilv_nodes_get(supported, itr);
+
+				if(!lilv_nodes_contains(features, node))
+				{
+					*app->urn = lv2lint_node_as_uri_strdup(node);
+					ret = &ret_features_not_valid;
+					break;
+				}
+			}
+
+			lilv_nodes_free(supported);
+		}
+
+		lilv_nodes_free(features);
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_extensions(app_t *app)
+{
+	static const ret_t ret_extensions_not_valid = {
+		.lnt = LINT_FAIL,
+		.msg = "lv2:extensionData <%s> not valid",
+		.uri = LV2_CORE__ExtensionData,
+		.dsc = "Make sure that the lv2:extensionData is defined somewhere."
+	},
+	ret_extensions_data_not_valid = {
+		.lnt = LINT_FAIL,
+		.msg = "extension data for <%s> not returned",
+		.uri = LV2_CORE__ExtensionData,
+		.dsc = "You likely do not properly check the URI in your plugin's "
+			"'extension_data' callback or don't have the latter at all."
+	},
+	ret_extensions_data_not_null = {
+		.lnt = LINT_FAIL,
+		.msg = "extension data for <%s> not NULL",
+		.uri = LV2_CORE__ExtensionData,
+		.dsc = "You likely do not properly check the URI in your plugin's "
+			"'extension_data' callback or don't have the latter at all."
+	};
+
+	const ret_t *ret = NULL;
+
+	if(app->instance)
+	{
+		const char *uri = "http://open-music-kontrollers.ch/lv2/lv2lint#dummy";
+		const void *ext = lilv_instance_get_extension_data(app->instance, uri);
+		if(ext)
+		{
+			*app->urn = lv2lint_strdup(uri);
+			ret = &ret_extensions_data_not_null;
+		}
+	}
+
+	LilvNodes *extensions = lilv_world_find_nodes(app->world,
+		NULL, NODE(app, RDF__type), NODE(app, CORE__ExtensionData));
+	if(extensions)
+	{
+		LilvNodes *data = lilv_plugin_get_extension_data(app->plugin);
+		if(data)
+		{
+			LILV_FOREACH(nodes, itr, data)
+			{
+				const LilvNode *node = lilv_nodes_get(data, itr);
+
+				if(!lilv_nodes_contains(extensions, node))
+				{
+					*app->urn = lv2lint_node_as_uri_strdup(node);
+					ret = &ret_extensions_not_valid;
+					break;
+				}
+
+				if(app->instance)
+				{
+					const char *uri = lilv_node_as_uri(node);
+					const void *ext = lilv_instance_get_extension_data(app->instance, uri);
+					if(!ext)
+					{
+						*app->urn = lv2lint_node_as_uri_strdup(node);
+						ret = &ret_extensions_data_not_valid;
+						break;
+					}
+				}
+			}
+
+			lilv_nodes_free(data);
+		}
+
+		lilv_nodes_free(extensions);
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_worker(app_t *app)
+{
+	static const ret_t ret_worker_schedule_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "work:schedule not defined",
+		.uri = LV2_WORKER__schedule,
+		.dsc = "The plugin exposes the worker extension, but does not list this "
+			"lv2:Feature."
+	},
+	ret_worker_interface_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "work:interface not defined",
+		.uri = LV2_WORKER__interface,
+		.dsc = "The plugin exposes the worker extension, but does not list this "
+			"lv2:ExtensionData."
+	},
+	ret_worker_interface_not_returned = {
+		.lnt = LINT_FAIL,
+		.msg = "work:interface not returned by 'extention_data'",
+		.uri = LV2_WORKER__interface,
+		.dsc = "The plugin returns no struct in 'extension_data' callback."
+	},
+	ret_worker_work_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "work:interface has no 'work' function",
+		.uri = LV2_WORKER__interface,
+		.dsc = NULL
+	},
+	ret_worker_work_response_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "work:interface has no 'work_response' function",
+		.uri = LV2_WORKER__interface,
+		.dsc = NULL
+	},
+	ret_worker_end_run_not_found = {
+		.lnt = LINT_NOTE,
+		.msg = "work:interface has no 'end_run' function",
+		.uri = LV2_WORKER__interface,
+		.dsc = NULL
+	};
+
+	const ret_t *ret = NULL;
+
+	const bool has_work_schedule= lilv_plugin_has_feature(app->plugin, NODE(app, WORKER__schedule));
+	const bool has_work_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, WORKER__interface));
+
+	if(has_work_schedule || has_work_iface || app->work_iface)
+	{
+		if(!app->work_iface)
+		{
+			ret = &ret_worker_interface_not_returned;
+		}
+		else if(!app->work_iface->work)
+		{
+			ret = &ret_worker_work_not_found;
+		}
+		else if(!app->work_iface->work_response)
+		{
+			ret = &ret_worker_work_response_not_found;
+		}
+		else if(!app->work_iface->end_run)
+		{
+			ret = &ret_worker_end_run_not_found;
+		}
+		else if(!has_work_schedule)
+		{
+			ret = &ret_worker_schedule_not_found;
+		}
+		else if(!has_work_iface)
+		{
+			ret = &ret_worker_interface_not_found;
+		}
+	}
+
+	return ret;
+}
+
+static const ret_t *
+_test_options_iface(app_t *app)
+{
+	static const ret_t ret_options_interface_not_found = {
 		.lnt = LINT_FAIL,
-		.msg = "doap:license not a URI",
-		.uri = LILV_NS_DOAP"license",
-		.dsc = NULL
+		.msg = "opts:interface not defined",
+		.uri = LV2_OPTIONS__interface,
+		.dsc = "The plugin exposes the options extension, but does not list this "
+			"lv2:Feature."
 	},
-#ifdef ENABLE_ONLINE_TESTS
-	ret_license_not_existing = {
-		.lnt = LINT_WARN,
-		.msg = "doap:license Web URL does not exist",
-		.uri = LILV_NS_DOAP"license",
-		.dsc = "It is good practice to have some online documentation at given URL."
+	ret_options_interface_not_returned = {
+		.lnt = LINT_FAIL,
+		.msg = "opts:interface not returned by 'extention_data'",
+		.uri = LV2_OPTIONS__interface,
+		.dsc = "The plugin returns no struct in 'extension_data' callback."
 	},
-#endif
-	ret_license_empty = {
+	ret_options_get_not_found = {
 		.lnt = LINT_FAIL,
-		.msg = "doap:license empty",
-		.uri = LILV_NS_DOAP"license",
+		.msg = "opts:interface has no 'get' function",
+		.uri = LV2_OPTIONS__interface,
+		.dsc = NULL
+	},
+	ret_options_set_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "opts:interface has no 'set' function",
+		.uri = LV2_OPTIONS__interface,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *license_node = lilv_world_get(app->world, lilv_plugin_get_uri(app->plugin), NODE(app, DOAP__license), NULL);
-	if (!license_node)
+	const bool has_opts_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, OPTIONS__interface));
+
+	if(has_opts_iface || app->opts_iface)
 	{
-		LilvNode *project_node = lilv_plugin_get_project(app->plugin);
-		if (project_node)
+		if(!app->opts_iface)
 		{
-			license_node = lilv_world_get(app->world, project_node, NODE(app, DOAP__license), NULL);
+			ret = &ret_options_interface_not_returned;
 		}
-	}
-
-	if(license_node)
-	{
-		if(lilv_node_is_uri(license_node))
+		else if(!app->opts_iface->get)
 		{
-			const char *uri = lilv_node_as_uri(license_node);
-
-			if(!uri)
-			{
-				ret = &ret_license_empty;
-			}
-#ifdef ENABLE_ONLINE_TESTS
-			else if(is_url(uri))
-			{
-				const bool url_exists = !app->online || test_url(app, uri);
-
-				if(!url_exists)
-				{
-					ret = &ret_license_not_existing;
-				}
-			}
-#endif
+			ret = &ret_options_get_not_found;
 		}
-		else
+		else if(!app->opts_iface->set)
 		{
-			ret = &ret_license_not_a_uri;
+			ret = &ret_options_set_not_found;
+		}
+		else if(!has_opts_iface)
+		{
+			ret = &ret_options_interface_not_found;
 		}
-		lilv_node_free(license_node);
-	}
-	else
-	{
-		ret = &ret_license_not_found;
 	}
 
 	return ret;
 }
 
-#define FOAF_DSC "You likely have not defined an lv2:project with " \
-	"a valid doap:maintainer or your plugin is not a subclass of doap:Project."
-
 static const ret_t *
-_test_author_name(app_t *app)
+_test_options_feature(app_t *app)
 {
-	static const ret_t ret_author_not_found = {
-		.lnt = LINT_WARN,
-		.msg = "foaf:name not found",
-		.uri = LV2_CORE__project,
-		.dsc = FOAF_DSC
-	},
-	ret_author_not_a_string = {
+	static const ret_t ret_options_options_not_found = {
 		.lnt = LINT_FAIL,
-		.msg = "foaf:name not a string",
-		.uri = LILV_NS_FOAF"name",
-		.dsc = FOAF_DSC
+		.msg = "opts:options not defined",
+		.uri = LV2_OPTIONS__options,
+		.dsc = "The plugin exposes the options extension, but does not list this "
+			"lv2:Feature."
 	},
-	ret_author_empty = {
-		.lnt = LINT_FAIL,
-		.msg = "foaf:name empty",
-		.uri = LILV_NS_FOAF"name",
-		.dsc = FOAF_DSC
+	ret_options_supported_not_found = {
+		.lnt = LINT_WARN,
+		.msg = "opts:{required,supported} options not defined",
+		.uri = LV2_OPTIONS__supportedOption,
+		.dsc = "The plugin exposes the options extension, but does not list any "
+			"required and/or supported options."
+	},
+	ret_options_required_found = {
+		.lnt = LINT_WARN,
+		.msg = "opts:required options defined",
+		.uri = LV2_OPTIONS__requiredOption,
+		.dsc = "Not all hosts may provide required options, thus make them optional."
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *author_name = lilv_plugin_get_author_name(app->plugin);
-	if(author_name)
+	const bool has_opts_options= lilv_plugin_has_feature(app->plugin, NODE(app, OPTIONS__options));
+	LilvNodes *required_options = lilv_plugin_get_value(app->plugin, NODE(app, OPTIONS__requiredOption));
+	LilvNodes *supported_options = lilv_plugin_get_value(app->plugin, NODE(app, OPTIONS__supportedOption));
+
+	const unsigned required_n = lilv_nodes_size(required_options);
+	const unsigned supported_n = lilv_nodes_size(supported_options);
+	const unsigned n = required_n + supported_n;
+
+	if(has_opts_options || n)
 	{
-		if(lilv_node_is_string(author_name))
+		if(!has_opts_options)
 		{
-			if(!lilv_node_as_string(author_name))
-			{
-				ret = &ret_author_empty;
-			}
+			ret = &ret_options_options_not_found;
 		}
-		else
+		else if(!n)
 		{
-			ret = &ret_author_not_a_string;
+			ret = &ret_options_supported_not_found;
 		}
-		lilv_node_free(author_name);
 	}
-	else
+	else if(required_n)
 	{
-		ret = &ret_author_not_found;
+		ret = &ret_options_required_found;
+	}
+
+	if(required_options)
+	{
+		lilv_nodes_free(required_options);
+	}
+
+	if(supported_options)
+	{
+		lilv_nodes_free(supported_options);
 	}
 
 	return ret;
 }
 
 static const ret_t *
-_test_author_email(app_t *app)
+_test_uri_map(app_t *app)
 {
-	static const ret_t ret_email_not_found = {
-		.lnt = LINT_WARN,
-		.msg = "foaf:mbox not found",
-		.uri = LV2_CORE__project,
-		.dsc = FOAF_DSC
-	},
-	ret_email_not_a_uri = {
-		.lnt = LINT_FAIL,
-		.msg = "foaf:mbox not a URI",
-		.uri = LILV_NS_FOAF"mbox",
-		.dsc = FOAF_DSC
-	},
-	ret_email_empty = {
+	static const ret_t ret_uri_map_deprecated = {
 		.lnt = LINT_FAIL,
-		.msg = "foaf:mbox empty",
-		.uri = LILV_NS_FOAF"mbox",
-		.dsc = FOAF_DSC
+		.msg = "uri-map is deprecated, use urid:map instead",
+		.uri = LV2_URI_MAP_URI,
+		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *author_email = lilv_plugin_get_author_email(app->plugin);
-	if(author_email)
-	{
-		if(lilv_node_is_uri(author_email))
-		{
-			if(!lilv_node_as_uri(author_email))
-			{
-				ret = &ret_email_empty;
-			}
-		}
-		else
-		{
-			ret = &ret_email_not_a_uri;
-		}
-		lilv_node_free(author_email);
-	}
-	else
+	if(lilv_plugin_has_feature(app->plugin, NODE(app, URI_MAP)))
 	{
-		ret = &ret_email_not_found;
+		ret = &ret_uri_map_deprecated;
 	}
 
 	return ret;
 }
 
 static const ret_t *
-_test_author_homepage(app_t *app)
+_test_state(app_t *app)
 {
-	static const ret_t ret_homepage_not_found = {
-		.lnt = LINT_WARN,
-		.msg = "foaf:homepage not found",
-		.uri = LV2_CORE__project,
-		.dsc = FOAF_DSC
+	static const ret_t ret_state_load_default_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "state:loadDefaultState not defined",
+		.uri = LV2_STATE__loadDefaultState,
+		.dsc = "The plugin has a default state, but does not list to load it in its "
+			"features."
 	},
-	ret_homepage_not_a_uri = {
+	ret_state_interface_not_found = {
 		.lnt = LINT_FAIL,
-		.msg = "foaf:homepage not a URI",
-		.uri = LILV_NS_FOAF"homepage",
-		.dsc = FOAF_DSC
+		.msg = "state:interface not defined",
+		.uri = LV2_STATE__interface,
+		.dsc = "The plugin makes use of the state extension, but does not list this "
+			"extension data."
 	},
-#ifdef ENABLE_ONLINE_TESTS
-	ret_homepage_not_existing = {
+	ret_state_state_not_found = {
 		.lnt = LINT_WARN,
-		.msg = "foaf:homepage Web URL does not exist",
-		.uri = LILV_NS_FOAF"homepage",
-		.dsc = FOAF_DSC
+		.msg = "state:state not defined",
+		.uri = LV2_STATE__state,
+		.dsc = "The plugin makes use of the state extension, but does not list "
+			"a default state."
 	},
-#endif
-	ret_homepage_empty = {
+	ret_state_interface_not_returned = {
 		.lnt = LINT_FAIL,
-		.msg = "foaf:homepage empty",
-		.uri = LILV_NS_FOAF"homepage",
-		.dsc = FOAF_DSC
+		.msg = "state:interface not returned by 'extension_data'",
+		.uri = LV2_STATE__interface,
+		.dsc = NULL
+	},
+	ret_state_save_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "state:interface has no 'save' function",
+		.uri = LV2_STATE__interface,
+		.dsc = NULL
+	},
+	ret_state_restore_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "state:interface has no 'restore' function",
+		.uri = LV2_STATE__interface,
+		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *author_homepage = lilv_plugin_get_author_homepage(app->plugin);
-	if(author_homepage)
+	const bool has_load_default = lilv_plugin_has_feature(app->plugin, NODE(app, STATE__loadDefaultState));
+	const bool has_thread_safe_restore = lilv_plugin_has_feature(app->plugin, NODE(app, STATE__threadSafeRestore));
+	const bool has_state = lilv_world_ask(app->world,
+		lilv_plugin_get_uri(app->plugin), NODE(app, STATE__state), NULL);
+	const bool has_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, STATE__interface));
+
+	if(has_load_default || has_thread_safe_restore || has_state || has_iface || app->state_iface)
 	{
-		if(lilv_node_is_uri(author_homepage))
+		if(!app->state_iface)
 		{
-			const char *uri = lilv_node_as_uri(author_homepage);
-
-			if(!uri)
+			ret = &ret_state_interface_not_returned;
+		}
+		else if(!app->state_iface->save)
+		{
+			ret = &ret_state_save_not_found;
+		}
+		else if(!app->state_iface->restore)
+		{
+			ret = &ret_state_restore_not_found;
+		}
+		else if(!has_iface)
+		{
+			ret = &ret_state_interface_not_found;
+		}
+		else if(has_load_default || has_state)
+		{
+			if(!has_load_default)
 			{
-				ret = &ret_homepage_empty;
+				ret = &ret_state_load_default_not_found;
 			}
-#ifdef ENABLE_ONLINE_TESTS
-			else if(is_url(uri))
+			else if(!has_state)
 			{
-				const bool url_exists = !app->online || test_url(app, uri);
-
-				if(!url_exists)
-				{
-					ret = &ret_homepage_not_existing;
-				}
+				ret = &ret_state_state_not_found;
 			}
-#endif
-		}
-		else
-		{
-			ret = &ret_homepage_not_a_uri;
 		}
-		lilv_node_free(author_homepage);
-	}
-	else
-	{
-		ret = &ret_homepage_not_found;
 	}
 
 	return ret;
 }
 
 static const ret_t *
-_test_version_minor(app_t *app)
+_test_comment(app_t *app)
 {
-	static const ret_t ret_version_minor_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "lv2:minorVersion not found",
-		.uri = LV2_CORE__minorVersion,
+	static const ret_t ret_comment_not_found = {
+		.lnt = LINT_NOTE,
+		.msg = "rdfs:comment or doap:description not found",
+		.uri = LV2_CORE__Plugin,
 		.dsc = NULL
 	},
-	ret_version_minor_not_an_int = {
+	ret_comment_not_a_string = {
 		.lnt = LINT_FAIL,
-		.msg = "lv2:minorVersion not an integer",
-		.uri = LV2_CORE__minorVersion,
+		.msg = "rdfs:comment not a string",
+		.uri = LILV_NS_RDFS"comment",
 		.dsc = NULL
 	},
-	ret_version_minor_unstable = {
-		.lnt = LINT_NOTE,
-		.msg = "lv2:minorVersion denotes an unstable version",
-		.uri = LV2_CORE__minorVersion,
+	ret_description_not_a_string = {
+		.lnt = LINT_FAIL,
+		.msg = "doap:description not a string",
+		.uri = LILV_NS_DOAP"description",
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNodes *minor_version_nodes = lilv_plugin_get_value(app->plugin , NODE(app, CORE__minorVersion));
-	if(minor_version_nodes)
+	LilvNode *comment = lilv_world_get(app->world,
+		lilv_plugin_get_uri(app->plugin), NODE(app, RDFS__comment), NULL);
+	LilvNode *description= lilv_world_get(app->world,
+		lilv_plugin_get_uri(app->plugin), NODE(app, DOAP__description), NULL);
+
+	if(comment)
 	{
-		const LilvNode *minor_version_node = lilv_nodes_get_first(minor_version_nodes);
-		if(minor_version_node)
+		if(!lilv_node_is_string(comment))
 		{
-			if(lilv_node_is_int(minor_version_node))
-			{
-				const int minor_version = lilv_node_as_int(minor_version_node);
-				if( (minor_version % 2 != 0) || (minor_version == 0) )
-				{
-					ret = &ret_version_minor_unstable;
-				}
-			}
-			else
-			{
-				ret = &ret_version_minor_not_an_int;
-			}
+			ret = &ret_comment_not_a_string;
 		}
-		else
+
+		lilv_node_free(comment);
+		if(description)
+			lilv_node_free(description);
+	}
+	else if(description)
+	{
+		if(!lilv_node_is_string(description))
 		{
-			ret = &ret_version_minor_not_found;
+			ret = &ret_description_not_a_string;
 		}
-		lilv_nodes_free(minor_version_nodes);
+
+		lilv_node_free(description);
 	}
 	else
 	{
-		ret = &ret_version_minor_not_found;
+		ret = &ret_comment_not_found;
 	}
 
 	return ret;
 }
 
 static const ret_t *
-_test_version_micro(app_t *app)
+_test_shortdesc(app_t *app)
 {
-	static const ret_t ret_version_micro_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "lv2:microVersion not found",
-		.uri = LV2_CORE__microVersion,
+	static const ret_t ret_shortdesc_not_found = {
+		.lnt = LINT_NOTE,
+		.msg = "doap:shortdesc not found",
+		.uri = LILV_NS_DOAP"shortdesc",
 		.dsc = NULL
 	},
-	ret_version_micro_not_an_int = {
+	ret_shortdesc_not_a_string = {
 		.lnt = LINT_FAIL,
-		.msg = "lv2:microVersion not an integer",
-		.uri = LV2_CORE__microVersion,
-		.dsc = NULL
-	},
-	ret_version_micro_unstable = {
-		.lnt = LINT_NOTE,
-		.msg = "lv2:microVersion denotes an unstable version",
-		.uri = LV2_CORE__microVersion,
+		.msg = "doap:shortdesc not a string",
+		.uri = LILV_NS_DOAP"shortdesc",
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNodes *micro_version_nodes = lilv_plugin_get_value(app->plugin , NODE(app, CORE__microVersion));
-	if(micro_version_nodes)
+	LilvNode *shortdesc = lilv_world_get(app->world,
+		lilv_plugin_get_uri(app->plugin), NODE(app, DOAP__shortdesc), NULL);
+	if(shortdesc)
 	{
-		const LilvNode *micro_version_node = lilv_nodes_get_first(micro_version_nodes);
-		if(micro_version_node)
-		{
-			if(lilv_node_is_int(micro_version_node))
-			{
-				const int micro_version = lilv_node_as_int(micro_version_node);
-				if(micro_version % 2 != 0)
-				{
-					ret = &ret_version_micro_unstable;
-				}
-			}
-			else
-			{
-				ret = &ret_version_micro_not_an_int;
-			}
-		}
-		else
+		if(!lilv_node_is_string(shortdesc))
 		{
-			ret = &ret_version_micro_not_found;
+			ret = &ret_shortdesc_not_a_string;
 		}
-		lilv_nodes_free(micro_version_nodes);
+
+		lilv_node_free(shortdesc);
 	}
 	else
 	{
-		ret = &ret_version_micro_not_found;
+		ret = &ret_shortdesc_not_found;
 	}
 
 	return ret;
 }
 
 static const ret_t *
-_test_project(app_t *app)
+_test_idisp(app_t *app)
 {
-	static const ret_t ret_project_not_found = {
-		.lnt = LINT_NOTE,
-		.msg = "lv2:project not found",
-		.uri = LV2_CORE__project,
-		.dsc = NULL
+	static const ret_t ret_idisp_queue_draw_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "idisp:queue_draw not defined",
+		.uri = LV2_INLINEDISPLAY__queue_draw,
+		.dsc = "The plugin makes use of the inline display extension, but does not "
+			"list this feature."
 	},
-	ret_project_name_not_found = {
-		.lnt = LINT_WARN,
-		.msg = "lv2:project doap:name not found",
-		.uri = LV2_CORE__project,
-		.dsc = NULL
+	ret_idisp_interface_not_found = {
+		.lnt = LINT_FAIL,
+		.msg = "idisp:interface not defined",
+		.uri = LV2_INLINEDISPLAY__interface,
+		.dsc = "The plugin makes use of the inline display extension, but does not "
+			"list this extension data."
 	},
-	ret_project_name_not_a_string = {
+	ret_idisp_interface_not_returned = {
 		.lnt = LINT_FAIL,
-		.msg = "lv2:project doap:name not a string",
-		.uri = LILV_NS_DOAP"name",
+		.msg = "idisp:interface not returned by 'extention_data'",
+		.uri = LV2_INLINEDISPLAY__interface,
 		.dsc = NULL
 	},
-	ret_project_name_empty = {
+	ret_idisp_render_not_found = {
 		.lnt = LINT_FAIL,
-		.msg = "lv2:project doap:name empty",
-		.uri = LILV_NS_DOAP"name",
+		.msg ="idisp:interface has no 'render' function",
+		.uri = LV2_INLINEDISPLAY__interface,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *project_node = lilv_plugin_get_project(app->plugin);
-	if(project_node)
+	const bool has_idisp_queue_draw = lilv_plugin_has_feature(app->plugin, NODE(app, INLINEDISPLAY__queue_draw));
+	const bool has_idisp_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, INLINEDISPLAY__interface));
+
+	if(has_idisp_queue_draw || has_idisp_iface || app->idisp_iface)
 	{
-		LilvNode *project_name_node = lilv_world_get(app->world, project_node, NODE(app, DOAP__name), NULL);
-		if(project_name_node)
+		if(!app->idisp_iface)
 		{
-			if(lilv_node_is_string(project_name_node))
-			{
-				if(!lilv_node_as_string(project_name_node))
-				{
-					ret = &ret_project_name_empty;
-				}
-			}
-			else
-			{
-				ret = &ret_project_name_not_a_string;
-			}
-			lilv_free(project_name_node);
+			ret = &ret_idisp_interface_not_returned;
 		}
-		else // !doap_name_node
+		else if(!app->idisp_iface->render)
 		{
-			ret = &ret_project_name_not_found;
+			ret = &ret_idisp_render_not_found;
+		}
+		else if(!has_idisp_queue_draw)
+		{
+			ret = &ret_idisp_queue_draw_not_found;
+		}
+		else if(!has_idisp_iface)
+		{
+			ret = &ret_idisp_interface_not_found;
 		}
-		lilv_node_free(project_node);
 	}
-	else // !project_node
+
+	return ret;
+}
+
+static const ret_t *
+_test_hard_rt_capable(app_t *app)
+{
+	static const ret_t ret_hard_rt_capable_not_found = {
+		.lnt = LINT_WARN,
+		.msg = "not advertized as real-time safe",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "If this plugin is meant to be used in a real-time context, you "
+			"should list this feature."
+	};
+
+	const ret_t *ret = NULL;
+
+	const bool is_hard_rt_capable = lilv_plugin_has_feature(app->plugin, NODE(app, CORE__hardRTCapable));
+
+	if(!is_hard_rt_capable)
 	{
-		ret = &ret_project_not_found;
+		ret = &ret_hard_rt_capable_not_found;
 	}
 
 	return ret;
 }
 
-static inline bool
-_test_class_equals(const LilvPluginClass *base, const LilvPluginClass *class)
+static const ret_t *
+_test_in_place_broken(app_t *app)
 {
-	return lilv_node_equals(
-		lilv_plugin_class_get_uri(base),
-		lilv_plugin_class_get_uri(class) );
-}
+	static const ret_t ret_in_place_broken_found = {
+		.lnt = LINT_WARN,
+		.msg = "cannot process audio/CV in-place",
+		.uri = LV2_CORE__inPlaceBroken,
+		.dsc = "Some hosts only support plugins that are capable of in-place "
+			"processing."
+	};
 
-static inline bool
-_test_class_match(const LilvPluginClass *base, const LilvPluginClass *class)
-{
-	if(_test_class_equals(base, class))
-	{
-		return true;
-	}
+	const ret_t *ret = NULL;
 
-	bool ret = false;
-	LilvPluginClasses *children= lilv_plugin_class_get_children(base);
-	if(children)
+	const bool is_in_place_broken = lilv_plugin_has_feature(app->plugin, NODE(app, CORE__inPlaceBroken));
+
+	if(is_in_place_broken)
 	{
-		LILV_FOREACH(plugin_classes, itr, children)
-		{
-			const LilvPluginClass *child = lilv_plugin_classes_get(children, itr);
-			if(_test_class_match(child, class))
-			{
-				ret = true;
-				break;
-			}
-		}
-		lilv_plugin_classes_free(children);
+		ret = &ret_in_place_broken_found;
 	}
 
 	return ret;
 }
 
 static const ret_t *
-_test_class(app_t *app)
+_test_in_place(app_t *app)
 {
-	static const ret_t ret_class_not_found = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "type not found",
-		.uri = LV2_CORE__Plugin,
-		.dsc = NULL
-	},
-	ret_class_is_base_class = {
-		.lnt = LINT_WARN,
-		.msg = "type is just lv2:Plugin",
-		.uri = LV2_CORE__Plugin,
-		.dsc = "If you give the plugin a proper class, hosts can better sort them."
+		.msg = "crashed when processing in-place",
+		.uri = LV2_CORE__inPlaceBroken,
+		.dsc = "Hosts connect audio inputs and outputs to the same buffer unless "
+			"the plugin lists lv2:inPlaceBroken."
 	},
-	ret_class_not_valid = {
+	ret_differs = {
 		.lnt = LINT_FAIL,
-		.msg = "type <%s> not valid",
-		.uri = LV2_CORE__Plugin,
+		.msg = "output differs when processing in-place: %s",
+		.uri = LV2_CORE__inPlaceBroken,
+		.dsc = "The plugin overwrites its input before having read it, either fix "
+			"the processing order or list lv2:inPlaceBroken."
+	},
+	ret_inplace = {
+		.lnt = LINT_NOTE,
+		.msg = "in-place processing: %s",
+		.uri = LV2_CORE__inPlaceBroken,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	const LilvPluginClass *class = lilv_plugin_get_class(app->plugin);
-	if(class)
+	if(app->status.inplace)
 	{
-		const LilvPluginClass *base = lilv_world_get_plugin_class(app->world);
-		if(_test_class_equals(base, class))
-		{
-			ret = &ret_class_is_base_class;
-		}
-		else if(!_test_class_match(base, class))
-		{
-			const LilvNode *class_uri = lilv_plugin_class_get_uri(class);
-			*app->urn = lv2lint_node_as_uri_strdup(class_uri);
-			ret = &ret_class_not_valid;
-		}
+		return &ret_crash;
 	}
-	else // !class
+
+	if(!app->instance || !app->inplace.valid)
 	{
-		ret = &ret_class_not_found;
+		return ret;
 	}
 
-	return ret;
-}
-
-static const ret_t *
-_test_features(app_t *app)
-{
-	static const ret_t ret_features_not_valid = {
-		.lnt = LINT_FAIL,
-		.msg = "lv2:[optional|required]Feature <%s> not valid",
-		.uri = LV2_CORE__Feature,
-		.dsc = "Make sure that the lv2:Feature is defined somewhere."
-	};
+	const double percent = app->inplace.separate > 0.0
+		? 100.0 * (app->inplace.inplace - app->inplace.separate) / app->inplace.separate
+		: 0.0;
+	char *urn = NULL;
+	char buf [128];
 
-	const ret_t *ret = NULL;
+	snprintf(buf, sizeof(buf), "%"PRIu32" audio pair(s)", app->inplace.pairs);
+	lv2lint_append_to(&urn, buf);
 
-	LilvNodes *features = lilv_world_find_nodes(app->world,
-		NULL, NODE(app, RDF__type), NODE(app, CORE__Feature));
-	if(features)
+	if(app->dsp.enabled)
 	{
-		LilvNodes *supported = lilv_plugin_get_supported_features(app->plugin);
-		if(supported)
-		{
-			LILV_FOREACH(nodes, itr, supported)
-			{
-				const LilvNode *node = lilv_nodes_get(supported, itr);
-
-				if(!lilv_nodes_contains(features, node))
-				{
-					*app->urn = lv2lint_node_as_uri_strdup(node);
-					ret = &ret_features_not_valid;
-					break;
-				}
-			}
-
-			lilv_nodes_free(supported);
-		}
+		snprintf(buf, sizeof(buf), "separate %.1f ns/sample, in-place %.1f ns/sample "
+			"(%+.1f%%)", app->inplace.separate, app->inplace.inplace, percent);
+		lv2lint_append_to(&urn, buf);
+	}
 
-		lilv_nodes_free(features);
+	if(!app->inplace.deterministic)
+	{
+		lv2lint_append_to(&urn, "output not reproducible, comparison skipped");
+		ret = &ret_inplace;
+	}
+	else if(app->inplace.diff > PERF_EPSILON)
+	{
+		snprintf(buf, sizeof(buf), "max difference %g", app->inplace.diff);
+		lv2lint_append_to(&urn, buf);
+		ret = &ret_differs;
 	}
+	else
+	{
+		ret = &ret_inplace;
+	}
+
+	*app->urn = urn;
 
 	return ret;
 }
 
 static const ret_t *
-_test_extensions(app_t *app)
+_test_misalign(app_t *app)
 {
-	static const ret_t ret_extensions_not_valid = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "lv2:extensionData <%s> not valid",
-		.uri = LV2_CORE__ExtensionData,
-		.dsc = "Make sure that the lv2:extensionData is defined somewhere."
+		.msg = "crashed with misaligned buffers: %s",
+		.uri = LV2_CORE__AudioPort,
+		.dsc = "Hosts may connect audio/CV ports to offsets into larger buffers, "
+			"only float alignment is guaranteed, use unaligned SIMD loads/stores "
+			"or a scalar path for unaligned heads and tails."
 	},
-	ret_extensions_data_not_valid = {
-		.lnt = LINT_FAIL,
-		.msg = "extension data for <%s> not returned",
-		.uri = LV2_CORE__ExtensionData,
-		.dsc = "You likely do not properly check the URI in your plugin's "
-			"'extension_data' callback or don't have the latter at all."
+	ret_differs = {
+		.lnt = LINT_WARN,
+		.msg = "output differs with misaligned buffers: %s",
+		.uri = LV2_CORE__AudioPort,
+		.dsc = "Alignment-dependent code paths should produce the same output, "
+			"check the handling of unaligned heads and tails."
 	},
-	ret_extensions_data_not_null = {
-		.lnt = LINT_FAIL,
-		.msg = "extension data for <%s> not NULL",
-		.uri = LV2_CORE__ExtensionData,
-		.dsc = "You likely do not properly check the URI in your plugin's "
-			"'extension_data' callback or don't have the latter at all."
+	ret_misalign = {
+		.lnt = LINT_NOTE,
+		.msg = "misaligned buffers: %s",
+		.uri = LV2_CORE__AudioPort,
+		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	if(app->instance)
+	if(!app->instance)
 	{
-		const char *uri = "http://open-music-kontrollers.ch/lv2/lv2lint#dummy";
-		const void *ext = lilv_instance_get_extension_data(app->instance, uri);
-		if(ext)
-		{
-			*app->urn = lv2lint_strdup(uri);
-			ret = &ret_extensions_data_not_null;
-		}
+		return ret;
 	}
 
-	LilvNodes *extensions = lilv_world_find_nodes(app->world,
-		NULL, NODE(app, RDF__type), NODE(app, CORE__ExtensionData));
-	if(extensions)
+	char *crashed = NULL;
+	char *differs = NULL;
+	char *urn = NULL;
+
+	for(unsigned i = 0; i < MISALIGN_MAX; i++)
 	{
-		LilvNodes *data = lilv_plugin_get_extension_data(app->plugin);
-		if(data)
+		const misalign_t *misalign = &app->misalign[i];
+		char buf [128];
+
+		if(app->status.misalign[i])
 		{
-			LILV_FOREACH(nodes, itr, data)
-			{
-				const LilvNode *node = lilv_nodes_get(data, itr);
+			snprintf(buf, sizeof(buf), "%zu bytes", MISALIGN_OFFSET(i));
+			lv2lint_append_to(&crashed, buf);
+			continue;
+		}
 
-				if(!lilv_nodes_contains(extensions, node))
-				{
-					*app->urn = lv2lint_node_as_uri_strdup(node);
-					ret = &ret_extensions_not_valid;
-					break;
-				}
+		if(!misalign->valid)
+		{
+			continue;
+		}
 
-				if(app->instance)
-				{
-					const char *uri = lilv_node_as_uri(node);
-					const void *ext = lilv_instance_get_extension_data(app->instance, uri);
-					if(!ext)
-					{
-						*app->urn = lv2lint_node_as_uri_strdup(node);
-						ret = &ret_extensions_data_not_valid;
-						break;
-					}
-				}
-			}
+		if(misalign->differs)
+		{
+			snprintf(buf, sizeof(buf), "%zu bytes (max difference %g)",
+				MISALIGN_OFFSET(i), misalign->diff);
+			lv2lint_append_to(&differs, buf);
+		}
 
-			lilv_nodes_free(data);
+		const double percent = misalign->aligned > 0.0
+			? 100.0 * (misalign->misaligned - misalign->aligned) / misalign->aligned
+			: 0.0;
+
+		if(app->dsp.enabled)
+		{
+			snprintf(buf, sizeof(buf), "%zu bytes: %.1f ns/sample vs. %.1f ns/sample "
+				"aligned (%+.1f%%)", MISALIGN_OFFSET(i), misalign->misaligned,
+				misalign->aligned, percent);
 		}
+		else
+		{
+			snprintf(buf, sizeof(buf), "%zu bytes", MISALIGN_OFFSET(i));
+		}
+		lv2lint_append_to(&urn, buf);
+	}
 
-		lilv_nodes_free(extensions);
+	if(crashed)
+	{
+		ret = &ret_crash;
+		*app->urn = crashed;
+		free(differs);
+		free(urn);
+	}
+	else if(differs)
+	{
+		ret = &ret_differs;
+		*app->urn = differs;
+		free(urn);
+	}
+	else if(urn)
+	{
+		ret = &ret_misalign;
+		*app->urn = urn;
 	}
 
 	return ret;
 }
 
+#define LAZY_RATIO 4.0 // tolerated first to steady-state run() cost
+#define LAZY_DEADLINE 0.1 // share of the block deadline a spike must exceed
+
+static bool
+_lazy_spike(app_t *app, double ns)
+{
+	const double deadline = 1e9 * app->dsp.nsamples / app->sample_rate;
+
+	return (ns > LAZY_RATIO * app->lazy.steady)
+		&& (ns - app->lazy.steady > LAZY_DEADLINE * deadline);
+}
+
 static const ret_t *
-_test_worker(app_t *app)
+_test_lazy(app_t *app)
 {
-	static const ret_t ret_worker_schedule_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "work:schedule not defined",
-		.uri = LV2_WORKER__schedule,
-		.dsc = "The plugin exposes the worker extension, but does not list this "
-			"lv2:Feature."
-	},
-	ret_worker_interface_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "work:interface not defined",
-		.uri = LV2_WORKER__interface,
-		.dsc = "The plugin exposes the worker extension, but does not list this "
-			"lv2:ExtensionData."
-	},
-	ret_worker_interface_not_returned = {
-		.lnt = LINT_FAIL,
-		.msg = "work:interface not returned by 'extention_data'",
-		.uri = LV2_WORKER__interface,
-		.dsc = "The plugin returns no struct in 'extension_data' callback."
-	},
-	ret_worker_work_not_found = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "work:interface has no 'work' function",
-		.uri = LV2_WORKER__interface,
-		.dsc = NULL
+		.msg = "crashed when reactivated",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
 	},
-	ret_worker_work_response_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "work:interface has no 'work_response' function",
-		.uri = LV2_WORKER__interface,
-		.dsc = NULL
+	ret_lazy = {
+		.lnt = LINT_WARN,
+		.msg = "lazy initialization in run(): %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Allocations and table building deferred to the first run() after "
+			"activation cause an xrun the first time a track plays, do them in "
+			"instantiate() or activate()."
 	},
-	ret_worker_end_run_not_found = {
+	ret_steady = {
 		.lnt = LINT_NOTE,
-		.msg = "work:interface has no 'end_run' function",
-		.uri = LV2_WORKER__interface,
+		.msg = "first vs. steady-state run(): %s",
+		.uri = LV2_CORE__hardRTCapable,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	const bool has_work_schedule= lilv_plugin_has_feature(app->plugin, NODE(app, WORKER__schedule));
-	const bool has_work_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, WORKER__interface));
+	if(app->status.lazy)
+	{
+		return &ret_crash;
+	}
+
+	if(!app->instance || !app->lazy.valid || (app->lazy.steady <= 0.0) )
+	{
+		return ret;
+	}
 
-	if(has_work_schedule || has_work_iface || app->work_iface)
+	const bool steady_clean = !app->lazy.steady_allocs
+		&& !app->lazy.steady_syscalls;
+	uint64_t first = 0;
+	uint64_t react = 0;
+	char *urn = NULL;
+	char buf [128];
+
+	for(unsigned i = 0; i < LAZY_FIRST; i++)
 	{
-		if(!app->work_iface)
-		{
-			ret = &ret_worker_interface_not_returned;
-		}
-		else if(!app->work_iface->work)
-		{
-			ret = &ret_worker_work_not_found;
-		}
-		else if(!app->work_iface->work_response)
-		{
-			ret = &ret_worker_work_response_not_found;
-		}
-		else if(!app->work_iface->end_run)
+		if(app->lazy.first[i] > first)
 		{
-			ret = &ret_worker_end_run_not_found;
-		}
-		else if(!has_work_schedule)
-		{
-			ret = &ret_worker_schedule_not_found;
+			first = app->lazy.first[i];
 		}
-		else if(!has_work_iface)
+
+		if(app->lazy.react[i] > react)
 		{
-			ret = &ret_worker_interface_not_found;
+			react = app->lazy.react[i];
 		}
 	}
 
+	snprintf(buf, sizeof(buf), "first %u after activation %.1f us at worst "
+		"(%.1fx steady state of %.1f us), %u allocations, %"PRIu64" syscalls",
+		LAZY_FIRST, first * 1e-3, first / app->lazy.steady,
+		app->lazy.steady * 1e-3, app->lazy.first_allocs,
+		app->lazy.first_syscalls);
+	lv2lint_append_to(&urn, buf);
+
+	snprintf(buf, sizeof(buf), "first %u after reactivation %.1f us at worst "
+		"(%.1fx), %u allocations, %"PRIu64" syscalls", LAZY_FIRST, react * 1e-3,
+		react / app->lazy.steady, app->lazy.react_allocs,
+		app->lazy.react_syscalls);
+	lv2lint_append_to(&urn, buf);
+
+	if(!steady_clean)
+	{
+		snprintf(buf, sizeof(buf), "steady state %u allocations, %"PRIu64" syscalls "
+			"in %u calls", app->lazy.steady_allocs, app->lazy.steady_syscalls,
+			LAZY_STEADY);
+		lv2lint_append_to(&urn, buf);
+	}
+
+	const bool first_only = steady_clean
+		&& (app->lazy.first_allocs || app->lazy.first_syscalls
+			|| app->lazy.react_allocs || app->lazy.react_syscalls);
+
+	ret = (first_only || _lazy_spike(app, first) || _lazy_spike(app, react))
+		? &ret_lazy
+		: &ret_steady;
+
+	*app->urn = urn;
+
 	return ret;
 }
 
+static const char *resource_lbls [RESOURCE_MAX] = {
+	[RESOURCE_heap] = "heap bytes",
+	[RESOURCE_rss] = "RSS bytes",
+	[RESOURCE_fds] = "file descriptors",
+	[RESOURCE_threads] = "threads"
+};
+
 static const ret_t *
-_test_options_iface(app_t *app)
+_test_cycle(app_t *app)
 {
-	static const ret_t ret_options_interface_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "opts:interface not defined",
-		.uri = LV2_OPTIONS__interface,
-		.dsc = "The plugin exposes the options extension, but does not list this "
-			"lv2:Feature."
-	},
-	ret_options_interface_not_returned = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "opts:interface not returned by 'extention_data'",
-		.uri = LV2_OPTIONS__interface,
-		.dsc = "The plugin returns no struct in 'extension_data' callback."
+		.msg = "crashed when cycling activation",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Hosts toggle activation on transport changes, sample-rate "
+			"switches and bypass, deactivate() must undo what activate() did."
 	},
-	ret_options_get_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "opts:interface has no 'get' function",
-		.uri = LV2_OPTIONS__interface,
-		.dsc = NULL
+	ret_leak = {
+		.lnt = LINT_WARN,
+		.msg = "resources grow with every activation cycle: %s",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Release in deactivate() what was acquired in activate(), or "
+			"acquire it once in instantiate()."
 	},
-	ret_options_set_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "opts:interface has no 'set' function",
-		.uri = LV2_OPTIONS__interface,
+	ret_cycle = {
+		.lnt = LINT_NOTE,
+		.msg = "activation cycle: %s",
+		.uri = LV2_CORE__Plugin,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	const bool has_opts_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, OPTIONS__interface));
+	if(app->status.cycle)
+	{
+		return &ret_crash;
+	}
 
-	if(has_opts_iface || app->opts_iface)
+	if(!app->instance || !app->cycle.valid)
 	{
-		if(!app->opts_iface)
-		{
-			ret = &ret_options_interface_not_returned;
-		}
-		else if(!app->opts_iface->get)
+		return ret;
+	}
+
+	char *leaks = NULL;
+	char *urn = NULL;
+	char buf [128];
+
+	snprintf(buf, sizeof(buf), "%.1f us per deactivate, activate and run()",
+		app->cycle.ns * 1e-3);
+	lv2lint_append_to(&urn, buf);
+
+	for(resource_t r = 0; r < RESOURCE_MAX; r++)
+	{
+		if(!app->cycle.avail[r] || !app->cycle.grows[r])
 		{
-			ret = &ret_options_get_not_found;
+			continue;
 		}
-		else if(!app->opts_iface->set)
+
+		snprintf(buf, sizeof(buf), "%.2f %s per cycle",
+			app->cycle.growth[r], resource_lbls[r]);
+
+		if(r == RESOURCE_rss) // also pages touched late, thus informative only
 		{
-			ret = &ret_options_set_not_found;
+			lv2lint_append_to(&urn, buf);
 		}
-		else if(!has_opts_iface)
+		else
 		{
-			ret = &ret_options_interface_not_found;
+			lv2lint_append_to(&leaks, buf);
 		}
 	}
 
+	if(leaks)
+	{
+		ret = &ret_leak;
+		*app->urn = leaks;
+		free(urn);
+	}
+	else
+	{
+		ret = &ret_cycle;
+		*app->urn = urn;
+	}
+
 	return ret;
 }
 
 static const ret_t *
-_test_options_feature(app_t *app)
+_test_stack(app_t *app)
 {
-	static const ret_t ret_options_options_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "opts:options not defined",
-		.uri = LV2_OPTIONS__options,
-		.dsc = "The plugin exposes the options extension, but does not list this "
-			"lv2:Feature."
-	},
-	ret_options_supported_not_found = {
+	static const ret_t ret_deep = {
 		.lnt = LINT_WARN,
-		.msg = "opts:{required,supported} options not defined",
-		.uri = LV2_OPTIONS__supportedOption,
-		.dsc = "The plugin exposes the options extension, but does not list any "
-			"required and/or supported options."
+		.msg = "realtime callbacks use much stack: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Hosts may run DSP threads with small stacks, allocate large "
+			"buffers in instantiate() instead of on the stack."
 	},
-	ret_options_required_found = {
-		.lnt = LINT_WARN,
-		.msg = "opts:required options defined",
-		.uri = LV2_OPTIONS__requiredOption,
-		.dsc = "Not all hosts may provide required options, thus make them optional."
+	ret_stack = {
+		.lnt = LINT_NOTE,
+		.msg = "stack used by realtime callbacks: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	const bool has_opts_options= lilv_plugin_has_feature(app->plugin, NODE(app, OPTIONS__options));
-	LilvNodes *required_options = lilv_plugin_get_value(app->plugin, NODE(app, OPTIONS__requiredOption));
-	LilvNodes *supported_options = lilv_plugin_get_value(app->plugin, NODE(app, OPTIONS__supportedOption));
+	if(!app->instance)
+	{
+		return ret;
+	}
 
-	const unsigned required_n = lilv_nodes_size(required_options);
-	const unsigned supported_n = lilv_nodes_size(supported_options);
-	const unsigned n = required_n + supported_n;
+	char *urn = NULL;
 
-	if(has_opts_options || n)
+	for(phase_t phase = PHASE_NONE + 1; phase < PHASE_MAX; phase++)
 	{
-		if(!has_opts_options)
+		const size_t depth = app->stack.depth[phase];
+		char buf [64];
+
+		if(!depth)
 		{
-			ret = &ret_options_options_not_found;
+			continue;
 		}
-		else if(!n)
+
+		snprintf(buf, sizeof(buf), "%s: %.1f KiB", phase_lbls[phase],
+			depth / 1024.0);
+		lv2lint_append_to(&urn, buf);
+
+		if(depth > app->stack.limit * 1024.0)
 		{
-			ret = &ret_options_supported_not_found;
+			ret = &ret_deep;
 		}
 	}
-	else if(required_n)
-	{
-		ret = &ret_options_required_found;
-	}
 
-	if(required_options)
+	if(urn)
 	{
-		lilv_nodes_free(required_options);
-	}
+		if(!ret)
+		{
+			ret = &ret_stack;
+		}
 
-	if(supported_options)
-	{
-		lilv_nodes_free(supported_options);
+		*app->urn = urn;
 	}
 
 	return ret;
 }
 
+#define WSS_LIMIT 1024.0 // KiB of plugin memory touched per run()
+
+static const char *wss_lbls [WSS_MAX] = {
+	[WSS_heap] = "heap",
+	[WSS_dso] = "DSO",
+	[WSS_ports] = "port buffers",
+	[WSS_other] = "other"
+};
+
 static const ret_t *
-_test_uri_map(app_t *app)
+_test_wss(app_t *app)
 {
-	static const ret_t ret_uri_map_deprecated = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "uri-map is deprecated, use urid:map instead",
-		.uri = LV2_URI_MAP_URI,
+		.msg = "crashed while estimating the working set",
+		.uri = LV2_CORE__Plugin,
+		.dsc = NULL
+	},
+	ret_large = {
+		.lnt = LINT_WARN,
+		.msg = "large working set per run(): %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Memory touched by every run() competes for caches and TLB with "
+			"all other plugins, keep state compact and access it locally."
+	},
+	ret_wss = {
+		.lnt = LINT_NOTE,
+		.msg = "working set per run(): %s",
+		.uri = LV2_CORE__hardRTCapable,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	if(lilv_plugin_has_feature(app->plugin, NODE(app, URI_MAP)))
+	if(app->status.wss)
 	{
-		ret = &ret_uri_map_deprecated;
+		return &ret_crash;
+	}
+
+	if(!app->instance || !app->wss.valid)
+	{
+		return ret;
+	}
+
+	char *urn = NULL;
+	char buf [64];
+	double plugin = 0.0;
+
+	for(wss_t w = 0; w < WSS_MAX; w++)
+	{
+		snprintf(buf, sizeof(buf), "%s %.1f KiB", wss_lbls[w], app->wss.kib[w]);
+		lv2lint_append_to(&urn, buf);
+
+		if(w != WSS_other)
+		{
+			plugin += app->wss.kib[w];
+		}
 	}
 
+	ret = plugin > WSS_LIMIT
+		? &ret_large
+		: &ret_wss;
+
+	*app->urn = urn;
+
 	return ret;
 }
 
 static const ret_t *
-_test_state(app_t *app)
+_test_cold(app_t *app)
 {
-	static const ret_t ret_state_load_default_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "state:loadDefaultState not defined",
-		.uri = LV2_STATE__loadDefaultState,
-		.dsc = "The plugin has a default state, but does not list to load it in its "
-			"features."
-	},
-	ret_state_interface_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "state:interface not defined",
-		.uri = LV2_STATE__interface,
-		.dsc = "The plugin makes use of the state extension, but does not list this "
-			"extension data."
-	},
-	ret_state_state_not_found = {
-		.lnt = LINT_WARN,
-		.msg = "state:state not defined",
-		.uri = LV2_STATE__state,
-		.dsc = "The plugin makes use of the state extension, but does not list "
-			"a default state."
-	},
-	ret_state_interface_not_returned = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "state:interface not returned by 'extension_data'",
-		.uri = LV2_STATE__interface,
+		.msg = "crashed with cold caches",
+		.uri = LV2_CORE__Plugin,
 		.dsc = NULL
 	},
-	ret_state_save_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "state:interface has no 'save' function",
-		.uri = LV2_STATE__interface,
-		.dsc = NULL
+	ret_deadline = {
+		.lnt = LINT_WARN,
+		.msg = "cold-cache run() exceeds block deadline: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "In a session many plugins share the caches, every run() starts "
+			"cold, keep state compact and access it sequentially."
 	},
-	ret_state_restore_not_found = {
-		.lnt = LINT_FAIL,
-		.msg = "state:interface has no 'restore' function",
-		.uri = LV2_STATE__interface,
+	ret_cold = {
+		.lnt = LINT_NOTE,
+		.msg = "cold vs. warm caches: %s",
+		.uri = LV2_CORE__hardRTCapable,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
-
-	const bool has_load_default = lilv_plugin_has_feature(app->plugin, NODE(app, STATE__loadDefaultState));
-	const bool has_thread_safe_restore = lilv_plugin_has_feature(app->plugin, NODE(app, STATE__threadSafeRestore));
-	const bool has_state = lilv_world_ask(app->world,
-		lilv_plugin_get_uri(app->plugin), NODE(app, STATE__state), NULL);
-	const bool has_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, STATE__interface));
-
-	if(has_load_default || has_thread_safe_restore || has_state || has_iface || app->state_iface)
-	{
-		if(!app->state_iface)
-		{
-			ret = &ret_state_interface_not_returned;
-		}
-		else if(!app->state_iface->save)
-		{
-			ret = &ret_state_save_not_found;
-		}
-		else if(!app->state_iface->restore)
-		{
-			ret = &ret_state_restore_not_found;
-		}
-		else if(!has_iface)
-		{
-			ret = &ret_state_interface_not_found;
-		}
-		else if(has_load_default || has_state)
-		{
-			if(!has_load_default)
-			{
-				ret = &ret_state_load_default_not_found;
-			}
-			else if(!has_state)
-			{
-				ret = &ret_state_state_not_found;
-			}
-		}
+
+	if(app->status.cold)
+	{
+		return &ret_crash;
+	}
+
+	if(!app->instance || !app->cold.valid || (app->cold.warm <= 0.0) )
+	{
+		return ret;
 	}
 
+	const double deadline = 1e9 * app->dsp.nsamples / app->sample_rate;
+	char *urn = NULL;
+	char buf [128];
+
+	snprintf(buf, sizeof(buf), "warm %.1f us, cold %.1f us per block (%.1fx, "
+		"%.1f%% of deadline), %zu MiB evicted", app->cold.warm * 1e-3,
+		app->cold.cold * 1e-3, app->cold.cold / app->cold.warm,
+		app->cold.cold / deadline * 100.0, app->cold.evict >> 20);
+	lv2lint_append_to(&urn, buf);
+
+	ret = app->cold.cold > deadline
+		? &ret_deadline
+		: &ret_cold;
+
+	*app->urn = urn;
+
 	return ret;
 }
 
+static void
+_soak_append(char **urn, app_t *app, const char *lbl, const occurrence_t *occ)
+{
+	char buf [128];
+
+	snprintf(buf, sizeof(buf), "%s: first after %.1f s, %"PRIu64" of %"PRIu64
+		" blocks (%.3g per s)", lbl, occ->first, occ->count, app->soak.blocks,
+		occ->count / app->soak.elapsed);
+	lv2lint_append_to(urn, buf);
+}
+
 static const ret_t *
-_test_comment(app_t *app)
+_test_soak(app_t *app)
 {
-	static const ret_t ret_comment_not_found = {
-		.lnt = LINT_NOTE,
-		.msg = "rdfs:comment or doap:description not found",
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed while soaking",
 		.uri = LV2_CORE__Plugin,
-		.dsc = NULL
+		.dsc = "Well - fix your plugin."
 	},
-	ret_comment_not_a_string = {
+	ret_nonrt = {
 		.lnt = LINT_FAIL,
-		.msg = "rdfs:comment not a string",
-		.uri = LILV_NS_RDFS"comment",
-		.dsc = NULL
+		.msg = "rare non-realtime calls in run(): %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Containers growing after many events or buffers flushed every "
+			"now and then block sooner or later, reserve and defer them to the "
+			"worker."
 	},
-	ret_description_not_a_string = {
-		.lnt = LINT_FAIL,
-		.msg = "doap:description not a string",
-		.uri = LILV_NS_DOAP"description",
+	ret_irregular = {
+		.lnt = LINT_WARN,
+		.msg = "irregularities while soaking: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Time waits for nothing."
+	},
+	ret_soak = {
+		.lnt = LINT_NOTE,
+		.msg = "soaked: %s",
+		.uri = LV2_CORE__hardRTCapable,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *comment = lilv_world_get(app->world,
-		lilv_plugin_get_uri(app->plugin), NODE(app, RDFS__comment), NULL);
-	LilvNode *description= lilv_world_get(app->world,
-		lilv_plugin_get_uri(app->plugin), NODE(app, DOAP__description), NULL);
+	if(app->status.soak)
+	{
+		return &ret_crash;
+	}
 
-	if(comment)
+	if(!app->instance || !app->soak.valid || !app->soak.blocks
+		|| (app->soak.elapsed <= 0.0) )
 	{
-		if(!lilv_node_is_string(comment))
+		return ret;
+	}
+
+	const int64_t growth = app->soak.heap[1] - app->soak.heap[0];
+	char *urn = NULL;
+	char buf [128];
+	bool nonrt = false;
+	bool irregular = false;
+
+	snprintf(buf, sizeof(buf), "%.1f s, %"PRIu64" blocks, %s, max %.1f us",
+		app->soak.elapsed, app->soak.blocks,
+		app->soak.seccomp ? "seccomp filtered" : "all syscalls traced",
+		app->soak.max * 1e-3);
+	lv2lint_append_to(&urn, buf);
+
+	for(shift_t s = 0; s < SHIFT_MAX; s++)
+	{
+		if(app->soak.shift[s].count)
 		{
-			ret = &ret_comment_not_a_string;
+			_soak_append(&urn, app, mask_lbls[s], &app->soak.shift[s]);
+
+			if(MASK(s) & MASK_ATOMIC)
+			{
+				irregular = true;
+			}
+			else
+			{
+				nonrt = true;
+			}
 		}
+	}
 
-		lilv_node_free(comment);
-		if(description)
-			lilv_node_free(description);
+	for(syscall_t call = 0; call < SYSCALL_MAX; call++)
+	{
+		if(app->soak.syscall[call].count)
+		{
+			_soak_append(&urn, app, syscall_to_name(call), &app->soak.syscall[call]);
+			nonrt = true;
+		}
 	}
-	else if(description)
+
+	if(app->soak.overrun.count)
 	{
-		if(!lilv_node_is_string(description))
+		_soak_append(&urn, app, "deadline missed", &app->soak.overrun);
+		irregular = true;
+	}
+
+	if(app->soak.samples > 1)
+	{
+		snprintf(buf, sizeof(buf), "heap %+"PRIi64" bytes (%.1f bytes per min), "
+			"RSS %+"PRIi64" bytes", growth, growth * 60.0 / app->soak.elapsed,
+			app->soak.rss[1] - app->soak.rss[0]);
+		lv2lint_append_to(&urn, buf);
+
+		if(app->soak.monotonic && (growth > 0) )
 		{
-			ret = &ret_description_not_a_string;
+			irregular = true;
 		}
+	}
 
-		lilv_node_free(description);
+	if(nonrt)
+	{
+		ret = &ret_nonrt;
+	}
+	else if(irregular)
+	{
+		ret = &ret_irregular;
 	}
 	else
 	{
-		ret = &ret_comment_not_found;
+		ret = &ret_soak;
 	}
 
+	*app->urn = urn;
+
 	return ret;
 }
 
 static const ret_t *
-_test_shortdesc(app_t *app)
+_test_leak(app_t *app)
 {
-	static const ret_t ret_shortdesc_not_found = {
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed in an instantiate to cleanup cycle",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Hosts rescan and reload plugins, a fresh instance must survive "
+			"its whole life cycle."
+	},
+	ret_leak = {
+		.lnt = LINT_WARN,
+		.msg = "heap leaked per instance after cleanup(): %s",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Free in cleanup() what was allocated by the instance, leaks add "
+			"up in hosts rescanning or reloading plugins."
+	},
+	ret_dropped = {
 		.lnt = LINT_NOTE,
-		.msg = "doap:shortdesc not found",
-		.uri = LILV_NS_DOAP"shortdesc",
+		.msg = "too many live allocations to track: %s",
+		.uri = LV2_CORE__Plugin,
 		.dsc = NULL
 	},
-	ret_shortdesc_not_a_string = {
-		.lnt = LINT_FAIL,
-		.msg = "doap:shortdesc not a string",
-		.uri = LILV_NS_DOAP"shortdesc",
+	ret_norun = {
+		.lnt = LINT_NOTE,
+		.msg = "no heap leaked per instance after cleanup(): %s",
+		.uri = LV2_CORE__Plugin,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	LilvNode *shortdesc = lilv_world_get(app->world,
-		lilv_plugin_get_uri(app->plugin), NODE(app, DOAP__shortdesc), NULL);
-	if(shortdesc)
+	if(app->status.leak)
 	{
-		if(!lilv_node_is_string(shortdesc))
+		return &ret_crash;
+	}
+
+	if(!app->instance || !app->leak.valid)
+	{
+		return ret;
+	}
+
+	char *urn = NULL;
+	char buf [256];
+	usage_t total = { .count = 0, .bytes = 0 };
+
+	for(phase_t phase = PHASE_NONE + 1; phase < PHASE_MAX; phase++)
+	{
+		total.count += app->leak.live[phase].count;
+		total.bytes += app->leak.live[phase].bytes;
+	}
+
+	if(total.count)
+	{
+		snprintf(buf, sizeof(buf), "%zu bytes in %u allocations",
+			total.bytes, total.count);
+		lv2lint_append_to(&urn, buf);
+
+		for(phase_t phase = PHASE_NONE + 1; phase < PHASE_MAX; phase++)
 		{
-			ret = &ret_shortdesc_not_a_string;
+			const usage_t *live = &app->leak.live[phase];
+
+			if(!live->count)
+			{
+				continue;
+			}
+
+			snprintf(buf, sizeof(buf), "%s: %zu bytes in %u allocations",
+				phase_lbls[phase], live->bytes, live->count);
+			lv2lint_append_to(&urn, buf);
 		}
 
-		lilv_node_free(shortdesc);
+		for(unsigned i = 0; (i < LEAK_TOP) && (i < app->leak.nsites); i++)
+		{
+			snprintf(buf, sizeof(buf), "%s: %zu bytes in %u allocations",
+				app->leak.top[i].name, app->leak.top[i].usage.bytes,
+				app->leak.top[i].usage.count);
+			lv2lint_append_to(&urn, buf);
+		}
+
+		ret = &ret_leak;
 	}
-	else
+	else if(app->leak.dropped)
 	{
-		ret = &ret_shortdesc_not_found;
+		snprintf(buf, sizeof(buf), "%u allocations not checked for leaks",
+			app->leak.dropped);
+		lv2lint_append_to(&urn, buf);
+
+		ret = &ret_dropped;
+	}
+	else if(app->leak.norun)
+	{
+		ret = &ret_norun;
+	}
+
+	if(ret && app->leak.norun)
+	{
+		lv2lint_append_to(&urn,
+			"run() not checked, the worker belongs to the main instance");
+	}
+
+	if(ret)
+	{
+		*app->urn = urn;
 	}
 
 	return ret;
 }
 
+#define SCALING_EFFICIENCY 0.75 // tolerated throughput relative to ideal scaling
+
 static const ret_t *
-_test_idisp(app_t *app)
+_test_scaling(app_t *app)
 {
-	static const ret_t ret_idisp_queue_draw_not_found = {
+	static const ret_t ret_crash = {
 		.lnt = LINT_FAIL,
-		.msg = "idisp:queue_draw not defined",
-		.uri = LV2_INLINEDISPLAY__queue_draw,
-		.dsc = "The plugin makes use of the inline display extension, but does not "
-			"list this feature."
+		.msg = "crashed with concurrent instances",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Hosts run many instances of the same plugin on several threads, "
+			"avoid unprotected global state."
 	},
-	ret_idisp_interface_not_found = {
+	ret_diverged = {
 		.lnt = LINT_FAIL,
-		.msg = "idisp:interface not defined",
-		.uri = LV2_INLINEDISPLAY__interface,
-		.dsc = "The plugin makes use of the inline display extension, but does not "
-			"list this extension data."
+		.msg = "instances fed identical input diverge: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Instances share state, e.g. via static variables, make it per "
+			"instance."
 	},
-	ret_idisp_interface_not_returned = {
-		.lnt = LINT_FAIL,
-		.msg = "idisp:interface not returned by 'extention_data'",
-		.uri = LV2_INLINEDISPLAY__interface,
-		.dsc = NULL
+	ret_contended = {
+		.lnt = LINT_WARN,
+		.msg = "concurrent instances contend: %s",
+		.uri = LV2_CORE__hardRTCapable,
+		.dsc = "Global locks, shared caches or false sharing between instances "
+			"serialize processing, keep state per instance and cache line aligned."
 	},
-	ret_idisp_render_not_found = {
-		.lnt = LINT_FAIL,
-		.msg ="idisp:interface has no 'render' function",
-		.uri = LV2_INLINEDISPLAY__interface,
+	ret_scaling = {
+		.lnt = LINT_NOTE,
+		.msg = "concurrent instances: %s",
+		.uri = LV2_CORE__hardRTCapable,
 		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	const bool has_idisp_queue_draw = lilv_plugin_has_feature(app->plugin, NODE(app, INLINEDISPLAY__queue_draw));
-	const bool has_idisp_iface = lilv_plugin_has_extension_data(app->plugin, NODE(app, INLINEDISPLAY__interface));
+	if(app->status.scaling)
+	{
+		return &ret_crash;
+	}
 
-	if(has_idisp_queue_draw || has_idisp_iface || app->idisp_iface)
+	if(!app->instance || !app->scaling.valid)
 	{
-		if(!app->idisp_iface)
-		{
-			ret = &ret_idisp_interface_not_returned;
-		}
-		else if(!app->idisp_iface->render)
-		{
-			ret = &ret_idisp_render_not_found;
-		}
-		else if(!has_idisp_queue_draw)
-		{
-			ret = &ret_idisp_queue_draw_not_found;
-		}
-		else if(!has_idisp_iface)
-		{
-			ret = &ret_idisp_interface_not_found;
-		}
+		return ret;
 	}
 
-	return ret;
-}
+	char *urn = NULL;
+	char buf [128];
 
-static const ret_t *
-_test_hard_rt_capable(app_t *app)
-{
-	static const ret_t ret_hard_rt_capable_not_found = {
-		.lnt = LINT_WARN,
-		.msg = "not advertized as real-time safe",
-		.uri = LV2_CORE__hardRTCapable,
-		.dsc = "If this plugin is meant to be used in a real-time context, you "
-			"should list this feature."
-	};
+	snprintf(buf, sizeof(buf), "%u instances at %.0f%% efficiency, "
+		"%.1f us/block alone, %.1f us/block concurrently", app->scaling.n,
+		100.0 * app->scaling.efficiency, app->scaling.single * 1e-3,
+		app->scaling.concurrent * 1e-3);
+	lv2lint_append_to(&urn, buf);
 
-	const ret_t *ret = NULL;
+	if(app->trace.syscalls)
+	{
+		snprintf(buf, sizeof(buf), "%"PRIu64" syscalls, %"PRIu64" futex calls "
+			"in %"PRIu64" run() calls", app->trace.syscalls, app->trace.futexes,
+			app->scaling.calls);
+		lv2lint_append_to(&urn, buf);
+	}
 
-	const bool is_hard_rt_capable = lilv_plugin_has_feature(app->plugin, NODE(app, CORE__hardRTCapable));
+	if(!app->scaling.deterministic)
+	{
+		lv2lint_append_to(&urn, "output not reproducible, divergence skipped");
+	}
+	else if(app->scaling.diverged)
+	{
+		snprintf(buf, sizeof(buf), "%u of %u instances, max difference %g",
+			app->scaling.diverged, app->scaling.n, app->scaling.diff);
+		lv2lint_append_to(&urn, buf);
+	}
 
-	if(!is_hard_rt_capable)
+	if(app->scaling.deterministic && app->scaling.diverged)
 	{
-		ret = &ret_hard_rt_capable_not_found;
+		ret = &ret_diverged;
+	}
+	else if(app->trace.futexes
+		|| (app->scaling.efficiency < SCALING_EFFICIENCY) )
+	{
+		ret = &ret_contended;
+	}
+	else
+	{
+		ret = &ret_scaling;
 	}
 
+	*app->urn = urn;
+
 	return ret;
 }
 
+#define DENSITY_DUPLICATED (256 << 10) // tolerated identical bytes per instance
+
 static const ret_t *
-_test_in_place_broken(app_t *app)
+_test_density(app_t *app)
 {
-	static const ret_t ret_in_place_broken_found = {
+	static const ret_t ret_crash = {
+		.lnt = LINT_FAIL,
+		.msg = "crashed with additional instances",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Well - fix your plugin."
+	},
+	ret_duplicated = {
 		.lnt = LINT_WARN,
-		.msg = "cannot process audio/CV in-place",
-		.uri = LV2_CORE__inPlaceBroken,
-		.dsc = "Some hosts only support plugins that are capable of in-place "
-			"processing."
+		.msg = "instances duplicate identical data: %s",
+		.uri = LV2_CORE__Plugin,
+		.dsc = "Read-only tables like wavetables, impulse responses or samples are "
+			"allocated and filled per instance, share them between instances, e.g. "
+			"reference counted or as static const data of the DSO."
+	},
+	ret_density = {
+		.lnt = LINT_NOTE,
+		.msg = "instance density: %s",
+		.uri = LV2_CORE__Plugin,
+		.dsc = NULL
 	};
 
 	const ret_t *ret = NULL;
 
-	const bool is_in_place_broken = lilv_plugin_has_feature(app->plugin, NODE(app, CORE__inPlaceBroken));
+	if(app->status.density)
+	{
+		return &ret_crash;
+	}
 
-	if(is_in_place_broken)
+	if(!app->instance || !app->density.valid)
 	{
-		ret = &ret_in_place_broken_found;
+		return ret;
+	}
+
+	char *urn = NULL;
+	char buf [128];
+
+	snprintf(buf, sizeof(buf), "%.1f KiB RSS, %.1f KiB PSS per instance "
+		"(fitted over %u instances)", app->density.rss / 1024.0,
+		app->density.pss / 1024.0, app->density.n);
+	lv2lint_append_to(&urn, buf);
+
+	snprintf(buf, sizeof(buf), "%.1f KiB RSS once for loading the DSO",
+		app->density.dso / 1024.0);
+	lv2lint_append_to(&urn, buf);
+
+	if(app->density.duplicated > 0.0)
+	{
+		snprintf(buf, sizeof(buf), "%.1f KiB of identical pages per instance",
+			app->density.duplicated / 1024.0);
+		lv2lint_append_to(&urn, buf);
 	}
 
+	ret = app->density.duplicated > DENSITY_DUPLICATED
+		? &ret_duplicated
+		: &ret_density;
+
+	*app->urn = urn;
+
 	return ret;
 }
 
@@ -1871,10 +3979,30 @@ _test_patch(app_t *app)
 static const test_t tests [] = {
 	{"Plugin LV2_PATH",        _test_lv2_path},
 	{"Plugin Instantiation",   _test_instantiation},
+	{"Plugin Instantiate Cost", _test_instantiation_cost},
 	{"Plugin Connect Port",    _test_connect_port},
 	{"Plugin Run",             _test_run},
 	{"Plugin Work",            _test_work},
 	{"Plugin Work Response",   _test_work_response},
+	{"Plugin Stack Usage",     _test_stack},
+	{"Plugin Memory Pool",     _test_mempool},
+	{"Plugin Host Calls",      _test_host_calls},
+	{"Plugin DSP Load",        _test_dsp_load},
+	{"Plugin Jitter",          _test_jitter},
+	{"Plugin Cold Cache",      _test_cold},
+	{"Plugin Soak",            _test_soak},
+	{"Plugin Perf Counters",   _test_counters},
+	{"Plugin Profile",         _test_profile},
+	{"Plugin Denormals",       _test_denormal},
+	{"Plugin Port Overrun",    _test_overrun},
+	{"Plugin Block Sizes",     _test_block},
+	{"Plugin Lazy Init",       _test_lazy},
+	{"Plugin Activation Cycle", _test_cycle},
+	{"Plugin Leaks",           _test_leak},
+	{"Plugin Working Set",     _test_wss},
+#ifdef FPCR_MASK
+	{"Plugin FP Control",      _test_fpcr},
+#endif
 	{"Plugin State Restore",   _test_state_restore},
 	{"Plugin Activate",        _test_activate},
 	{"Plugin Deactivate",      _test_deactivate},
@@ -1885,6 +4013,7 @@ static const test_t tests [] = {
 	{"Plugin Symbols",         _test_symbols},
 	{"Plugin Fork",            _test_fork},
 	{"Plugin Linking",         _test_linking},
+	{"Plugin Libatomic",       _test_libatomic},
 #endif
 	{"Plugin Verification",    _test_verification},
 	{"Plugin Name",            _test_name},
@@ -1908,6 +4037,10 @@ static const test_t tests [] = {
 	{"Plugin Inline Display",  _test_idisp},
 	{"Plugin Hard RT Capable", _test_hard_rt_capable},
 	{"Plugin In Place Broken", _test_in_place_broken},
+	{"Plugin In Place",        _test_in_place},
+	{"Plugin Misaligned",      _test_misalign},
+	{"Plugin Scaling",         _test_scaling},
+	{"Plugin Density",         _test_density},
 	{"Plugin Is Live",         _test_is_live},
 	//{"Plugin Bounded Block",   _test_bounded_block_length}, //TODO check for opts:opt
 	{"Plugin Fixed Block",     _test_fixed_block_length},
@@ -0,0 +1,416 @@
+/*
+ * SPDX-FileCopyrightText: Hanspeter Portner <dev@open-music-kontrollers.ch>
+ * SPDX-License-Identifier: Artistic-2.0
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <dlfcn.h>
+#include <link.h>
+
+#include <lv2lint/lv2lint.h>
+
+#ifdef ENABLE_ELF_TESTS
+#	include <fcntl.h>
+#	include <libelf.h>
+#	include <gelf.h>
+#endif
+
+#define PROFILE_SKIP 2 // signal handler and trampoline frames
+
+static const char self_anchor = 0; // locates the host executable via dladdr
+
+typedef struct _sym_t sym_t;
+typedef struct _dso_t dso_t;
+typedef struct _count_t count_t;
+
+struct _sym_t {
+	uintptr_t addr;
+	uintptr_t size;
+	char *name;
+};
+
+struct _dso_t {
+	uintptr_t base;
+	unsigned nsyms;
+	sym_t *syms;
+};
+
+struct _count_t {
+	char *str;
+	uint32_t count;
+};
+
+static int
+_sym_cmp(const void *a, const void *b)
+{
+	const sym_t *A = a;
+	const sym_t *B = b;
+
+	return (A->addr > B->addr) - (A->addr < B->addr);
+}
+
+static int
+_str_cmp(const void *a, const void *b)
+{
+	const count_t *A = a;
+	const count_t *B = b;
+
+	return strcmp(A->str, B->str);
+}
+
+static int
+_count_cmp(const void *a, const void *b)
+{
+	const count_t *A = a;
+	const count_t *B = b;
+
+	return (B->count > A->count) - (B->count < A->count);
+}
+
+#ifdef ENABLE_ELF_TESTS
+// also static functions, unlike dladdr, which only sees the dynamic symbols
+static void
+_dso_load(dso_t *dso, const char *path)
+{
+	const int fd = open(path, O_RDONLY);
+	if(fd == -1)
+	{
+		return;
+	}
+
+	elf_version(EV_CURRENT);
+
+	Elf *elf = elf_begin(fd, ELF_C_READ, NULL);
+	if(elf)
+	{
+		for(Elf_Scn *scn = elf_nextscn(elf, NULL);
+			scn;
+			scn = elf_nextscn(elf, scn))
+		{
+			GElf_Shdr shdr;
+			memset(&shdr, 0x0, sizeof(GElf_Shdr));
+			gelf_getshdr(scn, &shdr);
+
+			if( (shdr.sh_type != SHT_SYMTAB) && (shdr.sh_type != SHT_DYNSYM) )
+			{
+				continue;
+			}
+
+			Elf_Data *data = elf_getdata(scn, NULL);
+			const unsigned count = shdr.sh_size / shdr.sh_entsize;
+
+			sym_t *syms = realloc(dso->syms, (dso->nsyms + count) * sizeof(sym_t));
+			if(!syms)
+			{
+				break;
+			}
+
+			dso->syms = syms;
+
+			for(unsigned i = 0; i < count; i++)
+			{
+				GElf_Sym sym;
+				memset(&sym, 0x0, sizeof(GElf_Sym));
+				gelf_getsym(data, i, &sym);
+
+				if( (GELF_ST_TYPE(sym.st_info) != STT_FUNC) || !sym.st_value)
+				{
+					continue;
+				}
+
+				const char *name = elf_strptr(elf, shdr.sh_link, sym.st_name);
+				if(!name)
+				{
+					continue;
+				}
+
+				sym_t *dst = &dso->syms[dso->nsyms++];
+
+				dst->addr = sym.st_value;
+				dst->size = sym.st_size;
+				dst->name = lv2lint_strdup(name);
+			}
+		}
+
+		elf_end(elf);
+	}
+
+	close(fd);
+
+	qsort(dso->syms, dso->nsyms, sizeof(sym_t), _sym_cmp);
+}
+#endif
+
+static const char *
+_dso_lookup(const dso_t *dso, uintptr_t addr)
+{
+	const uintptr_t off = addr - dso->base;
+	unsigned lo = 0;
+	unsigned hi = dso->nsyms;
+
+	// last symbol starting at or below the offset
+	while(lo < hi)
+	{
+		const unsigned mid = (lo + hi) / 2;
+
+		if(dso->syms[mid].addr <= off)
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+
+	if(lo == 0)
+	{
+		return NULL;
+	}
+
+	const sym_t *sym = &dso->syms[lo - 1];
+
+	if(sym->size && (off >= sym->addr + sym->size) )
+	{
+		return NULL;
+	}
+
+	return sym->name;
+}
+
+static dso_t *
+_dso_get(dso_t **dsos, unsigned *ndsos, uintptr_t base,
+	const char *path __attribute__((unused)))
+{
+	for(unsigned i = 0; i < *ndsos; i++)
+	{
+		if((*dsos)[i].base == base)
+		{
+			return &(*dsos)[i];
+		}
+	}
+
+	dso_t *tmp = realloc(*dsos, (*ndsos + 1) * sizeof(dso_t));
+	if(!tmp)
+	{
+		return NULL;
+	}
+
+	*dsos = tmp;
+
+	dso_t *dso = &tmp[(*ndsos)++];
+	memset(dso, 0x0, sizeof(dso_t));
+	dso->base = base;
+#ifdef ENABLE_ELF_TESTS
+	_dso_load(dso, path);
+#endif
+
+	return dso;
+}
+
+static void
+_dsos_free(dso_t *dsos, unsigned ndsos)
+{
+	for(unsigned i = 0; i < ndsos; i++)
+	{
+		for(unsigned j = 0; j < dsos[i].nsyms; j++)
+		{
+			free(dsos[i].syms[j].name);
+		}
+
+		free(dsos[i].syms);
+	}
+
+	free(dsos);
+}
+
+static void
+_count(count_t *counts, uint32_t *ncounts)
+{
+	uint32_t n = 0;
+
+	qsort(counts, *ncounts, sizeof(count_t), _str_cmp);
+
+	// merge runs of equal strings
+	for(uint32_t i = 0; i < *ncounts; i++)
+	{
+		if(n && !strcmp(counts[n - 1].str, counts[i].str))
+		{
+			counts[n - 1].count += counts[i].count;
+			free(counts[i].str);
+		}
+		else
+		{
+			counts[n++] = counts[i];
+		}
+	}
+
+	*ncounts = n;
+}
+
+bool
+lv2lint_profile_fold(app_t *app)
+{
+	Dl_info self;
+	struct link_map *map = NULL;
+	dso_t *dsos = NULL;
+	unsigned ndsos = 0;
+	uint32_t nstacks = 0;
+
+	if(!dladdr(&self_anchor, &self))
+	{
+		return false;
+	}
+
+	count_t *stacks = calloc(app->profile.nsamples, sizeof(count_t));
+	count_t *leafs = calloc(app->profile.nsamples, sizeof(count_t));
+
+	if(!stacks || !leafs)
+	{
+		free(stacks);
+		free(leafs);
+		return false;
+	}
+
+	for(uint32_t s = 0; s < app->profile.nsamples; s++)
+	{
+		char names [PROFILE_DEPTH][PROFILE_NAME_MAX];
+		unsigned nnames = 0;
+
+		for(unsigned f = PROFILE_SKIP; f < app->profile.depth[s]; f++)
+		{
+			// return addresses point past the call
+			const uintptr_t addr = (uintptr_t)app->profile.frames[s][f]
+				- (f > PROFILE_SKIP ? 1 : 0);
+			Dl_info info;
+
+			if(!dladdr1((void *)addr, &info, (void **)&map, RTLD_DL_LINKMAP))
+			{
+				snprintf(names[nnames++], PROFILE_NAME_MAX, "[unknown]");
+				continue;
+			}
+
+			// host frames below the plugin
+			if(info.dli_fbase == self.dli_fbase)
+			{
+				break;
+			}
+
+			dso_t *dso = _dso_get(&dsos, &ndsos, map->l_addr, info.dli_fname);
+			const char *name = dso ? _dso_lookup(dso, addr) : NULL;
+
+			if(!name)
+			{
+				name = info.dli_sname;
+			}
+
+			if(name)
+			{
+				snprintf(names[nnames++], PROFILE_NAME_MAX, "%s", name);
+			}
+			else
+			{
+				const char *base = strrchr(info.dli_fname, '/');
+
+				snprintf(names[nnames++], PROFILE_NAME_MAX, "[%s+0x%"PRIxPTR"]",
+					base ? base + 1 : info.dli_fname, addr - map->l_addr);
+			}
+		}
+
+		if(nnames == 0) // not inside the plugin
+		{
+			continue;
+		}
+
+		size_t len = strlen(app->plugin_uri) + 1;
+
+		for(unsigned n = 0; n < nnames; n++)
+		{
+			len += strlen(names[n]) + 1;
+		}
+
+		char *stack = malloc(len);
+		char *leaf = lv2lint_strdup(names[0]);
+
+		if(!stack || !leaf)
+		{
+			free(stack);
+			free(leaf);
+			continue;
+		}
+
+		// folded stacks go from root to leaf
+		strcpy(stack, app->plugin_uri);
+
+		for(unsigned n = nnames; n > 0; n--)
+		{
+			strcat(stack, ";");
+			strcat(stack, names[n - 1]);
+		}
+
+		stacks[nstacks].str = stack;
+		stacks[nstacks].count = 1;
+		leafs[nstacks].str = leaf;
+		leafs[nstacks].count = 1;
+		nstacks++;
+	}
+
+	app->profile.hits = nstacks;
+
+	uint32_t nleafs = nstacks;
+
+	_count(stacks, &nstacks);
+	_count(leafs, &nleafs);
+
+	FILE *f = fopen(app->profile.path, "a");
+	if(f)
+	{
+		for(uint32_t i = 0; i < nstacks; i++)
+		{
+			fprintf(f, "%s %"PRIu32"\n", stacks[i].str, stacks[i].count);
+		}
+
+		fclose(f);
+	}
+
+	qsort(leafs, nleafs, sizeof(count_t), _count_cmp);
+
+	for(uint32_t i = 0; i < nleafs; i++)
+	{
+		if(i < PROFILE_TOP)
+		{
+			app->profile.top[i].name = leafs[i].str; // steal
+			app->profile.top[i].count = leafs[i].count;
+		}
+		else
+		{
+			free(leafs[i].str);
+		}
+	}
+
+	for(uint32_t i = 0; i < nstacks; i++)
+	{
+		free(stacks[i].str);
+	}
+
+	free(stacks);
+	free(leafs);
+	_dsos_free(dsos, ndsos);
+
+	return f != NULL;
+}
+
+void
+lv2lint_profile_free(app_t *app)
+{
+	for(unsigned i = 0; i < PROFILE_TOP; i++)
+	{
+		free(app->profile.top[i].name);
+	}
+
+	memset(app->profile.top, 0x0, sizeof(app->profile.top));
+	app->profile.nsamples = 0;
+	app->profile.hits = 0;
+}
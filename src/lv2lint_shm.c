@@ -8,9 +8,18 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <lv2lint/lv2lint_shm.h>
 
+// keep the single flag the interposer tests on its hot path up to date
+static inline void
+_watch(shm_t *shm)
+{
+	shm->watch = !shm->paused
+		&& (shm->enabled || (shm->phase != PHASE_NONE) || shm->tracking);
+}
+
 shm_t *
 shm_attach()
 {
@@ -43,8 +52,18 @@ shm_attach()
 
 	close(fd);
 
+	shm->watch = false;
 	shm->enabled = false;
+	shm->paused = false;
+	shm->phase = PHASE_NONE;
 	shm->mask = 0;
+	memset(shm->libm, 0x0, sizeof(shm->libm));
+	memset(shm->heap, 0x0, sizeof(shm->heap));
+	shm->tracking = false;
+	atomic_flag_clear(&shm->lock);
+	shm->dropped = 0;
+	memset(shm->outstanding, 0x0, sizeof(shm->outstanding));
+	memset(shm->live, 0x0, sizeof(shm->live));
 
 	return shm;
 }
@@ -62,31 +81,72 @@ shm_detach()
 void
 shm_resume(shm_t *shm)
 {
-	shm->enabled = true;
+	shm->paused = false;
+	_watch(shm);
 }
 
 void
 shm_enable(shm_t *shm)
 {
-	shm_resume(shm);
+	shm->enabled = true;
 	shm->mask = 0;
+	memset(shm->libm, 0x0, sizeof(shm->libm));
+	_watch(shm);
 }
 
-void
+bool
 shm_pause(shm_t *shm)
 {
-	shm->enabled = false;
+	const bool paused = shm->paused;
+
+	shm->paused = true;
+	_watch(shm);
+
+	return paused;
 }
 
 unsigned
 shm_disable(shm_t *shm)
 {
-	shm_pause(shm);
+	shm->enabled = false;
+	_watch(shm);
+
 	return shm->mask;
 }
 
 bool
 shm_enabled(shm_t *shm)
 {
-	return shm->enabled;
+	return shm->enabled && !shm->paused;
+}
+
+void
+shm_enter(shm_t *shm, phase_t phase)
+{
+	shm->phase = phase;
+	_watch(shm);
+}
+
+void
+shm_leave(shm_t *shm)
+{
+	shm->phase = PHASE_NONE;
+	_watch(shm);
+}
+
+void
+shm_track(shm_t *shm)
+{
+	memset(shm->live, 0x0, sizeof(shm->live));
+	memset(shm->outstanding, 0x0, sizeof(shm->outstanding));
+	shm->dropped = 0;
+	shm->tracking = true;
+	_watch(shm);
+}
+
+void
+shm_untrack(shm_t *shm)
+{
+	shm->tracking = false;
+	_watch(shm);
 }
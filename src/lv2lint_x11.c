@@ -342,14 +342,13 @@ test_x11(app_t *app, bool *flag)
 	};
 #pragma GCC diagnostic pop
 
-	const float param_sample_rate = 48000.f;
 	const float ui_update_rate = 25.f;
 
 	const LV2_Options_Option opts_sampleRate = {
 		.key = PARAMETERS__sampleRate,
 		.size = sizeof(float),
 		.type = ATOM__Float,
-		.value = &param_sample_rate
+		.value = &app->sample_rate
 	};
 	const LV2_Options_Option opts_updateRate = {
 		.key = UI__updateRate,